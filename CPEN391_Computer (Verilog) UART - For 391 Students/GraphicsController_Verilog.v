@@ -45,6 +45,8 @@ module  GraphicsController_Verilog (
 	
 		// WIRES/REGs etc
 	reg signed [15:0] X1, Y1, X2, Y2, Colour, BackGroundColour, Command;			// registers
+	reg unsigned [15:0] PixelData;									// next pixel colour for a Blit command
+	reg signed [15:0] DestX, DestY;									// where a CopyRect command copies its rectangle to
 	reg signed [15:0] Colour_Latch;									// holds data read from a pixel
 
 	// signals to control/select the registers above
@@ -54,10 +56,17 @@ module  GraphicsController_Verilog (
 			Y2_Select_H,
 			Command_Select_H, 
 			Colour_Select_H,
-			BackGroundColour_Select_H;
+			BackGroundColour_Select_H,
+			PixelData_Select_H,
+			VSyncClear_Select_H,
+			DestX_Select_H,
+			DestY_Select_H;
 	
 	reg CommandWritten_H, ClearCommandWritten_H;						// signals to control that a command request has been logged
+	reg PixelDataWritten_H, ClearPixelDataWritten_H;				// signals to control that a pixel for a Blit has been written and not yet drawn
 	reg Idle_H, SetBusy_H, ClearBusy_H;									// signals to control status of the graphics chip				
+	reg VSync_Meta_L, VSync_Sync_L, VSync_Last_L;					// VSync_L brought into our clock domain, and its value on the last clock
+	reg VSyncSeen_H;															// signals that a vertical sync has started since the CPU last cleared it
 	
 	// Temporary Asynchronous signals that drive the Ram (made synchronous in a register for the state machine)
 	// your Verilog code should drive these signals not the real Sram signals.
@@ -125,6 +134,15 @@ module  GraphicsController_Verilog (
 	reg signed [15:0] i;
 	reg signed [15:0] i_Data;
 
+	// where the last line ended (its X2,Y2), which is where a LineTo command starts
+	reg signed [15:0] LastX2, LastY2;
+
+	// where the pixel being copied by a CopyRect goes, and whether the copy runs right to left and bottom to top
+	reg signed [15:0] CopyDestX, CopyDestY;
+	wire CopyLeft, CopyUp;
+	reg LineEnd_Load_H;
+	wire signed [15:0] LineStartX, LineStartY;
+
 	// load enables for line drawing algorithm registers
 	reg x_Load_H;
 	reg y_Load_H;
@@ -165,6 +183,11 @@ module  GraphicsController_Verilog (
 	reg signed [15:0] crit;
 	reg signed [15:0] crit_Data;
 
+	// octants of the circle drawn, all 8 for a circle or those in Y2 for an arc
+	// (bit 0 is the octant clockwise from 3 o'clock, bit 1 the next one clockwise and so on)
+	reg [7:0] Octants;
+	reg [7:0] Octants_Data;
+
 	// load enables for circle drawing algorithm registers
 	reg centreX_Load_H;
 	reg centreY_Load_H;
@@ -172,6 +195,39 @@ module  GraphicsController_Verilog (
 	reg offset_x_Load_H;
 	reg offset_y_Load_H;
 	reg crit_Load_H;
+	reg Octants_Load_H;
+
+	// Ellipse drawing algorithm signals (the centre and offsets are the circle's registers).
+	// The decision variable is kept 4 times its real value so it stays a whole number, which
+	// for radii up to 1023 needs more than 32 bits
+	reg signed [47:0] ellipse_a2;								// X radius squared
+	reg signed [47:0] ellipse_a2_Data;
+
+	reg signed [47:0] ellipse_b2;								// Y radius squared
+	reg signed [47:0] ellipse_b2_Data;
+
+	reg signed [47:0] ellipse_dx;								// 2 * b2 * offset_x
+	reg signed [47:0] ellipse_dx_Data;
+
+	reg signed [47:0] ellipse_dy;								// 2 * a2 * offset_y
+	reg signed [47:0] ellipse_dy_Data;
+
+	reg signed [47:0] ellipse_d;
+	reg signed [47:0] ellipse_d_Data;
+
+	reg ellipse_region2;											// 1 once the ellipse is steeper than 45 degrees
+	reg ellipse_region2_Data;
+
+	reg signed [47:0] ellipse_dx_next;
+	reg signed [47:0] ellipse_dy_next;
+
+	// load enables for ellipse drawing algorithm registers
+	reg ellipse_a2_Load_H;
+	reg ellipse_b2_Load_H;
+	reg ellipse_dx_Load_H;
+	reg ellipse_dy_Load_H;
+	reg ellipse_d_Load_H;
+	reg ellipse_region2_Load_H;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // States and Parameters for State machine
@@ -224,6 +280,31 @@ module  GraphicsController_Verilog (
 	parameter DrawCircleCheckCrit = 8'h1b;
 	parameter DrawCircleEndMainLoop = 8'h1c;
 
+	// New state for drawing a filled rectangle
+	parameter DrawFilledRect = 8'h1d;
+
+	// New state for copying a rectangle of pixels written by the CPU
+	parameter DrawBlit = 8'h1e;
+
+	// New states for drawing an ellipse
+	parameter DrawEllipse = 8'h1f;
+	parameter DrawEllipse1 = 8'h20;
+	parameter DrawEllipseStartRegion1 = 8'h21;
+	parameter DrawEllipseQuadrant1 = 8'h22;
+	parameter DrawEllipseQuadrant2 = 8'h23;
+	parameter DrawEllipseQuadrant3 = 8'h24;
+	parameter DrawEllipseQuadrant4 = 8'h25;
+	parameter DrawEllipseStepRegion1 = 8'h26;
+	parameter DrawEllipseRegion2 = 8'h27;
+	parameter DrawEllipseStartRegion2 = 8'h28;
+	parameter DrawEllipseStepRegion2 = 8'h29;
+
+	// New states for copying a rectangle of the frame buffer to somewhere else in it
+	parameter DrawCopy = 8'h2a;
+	parameter DrawCopyRead = 8'h2b;
+	parameter DrawCopyRead1 = 8'h2c;
+	parameter DrawCopyWrite = 8'h2d;
+
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Commands values that can be written to command register by CPU to get graphics controller to draw a shape
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -235,6 +316,12 @@ module  GraphicsController_Verilog (
 	parameter GetPixel = 16'h000b;							// command to read a pixel
 	parameter ProgramPallette = 16'h0010;					// command is program one of the 256 pallettes with a new RGB value
 	parameter Circle = 16'h0011;
+	parameter FilledRect = 16'h0012;						// command is draw filled rectangle from X1,Y1 up to (not including) X2,Y2
+	parameter Blit = 16'h0013;								// command is fill X1,Y1 up to (not including) X2,Y2 with pixels written to PixelData
+	parameter LineTo = 16'h0014;							// command is draw a line from where the last line ended to X2,Y2 (X1,Y1 are not used)
+	parameter Ellipse = 16'h0015;							// command is draw an ellipse centred on X1,Y1 with X radius X2 and Y radius Y2
+	parameter Arc = 16'h0016;								// command is draw the octants of a circle in Y2[7:0], centred on X1,Y1 with radius X2
+	parameter CopyRect = 16'h0017;							// command is copy X1,Y1 up to (not including) X2,Y2 to DestX,DestY (they may overlap)
 	
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Secondary address decoder within chip
@@ -252,6 +339,10 @@ module  GraphicsController_Verilog (
 		Colour_Select_H 				= 0;
 		BackGroundColour_Select_H 	= 0;
 		Command_Select_H 				= 0;
+		PixelData_Select_H 			= 0;
+		VSyncClear_Select_H 			= 0;
+		DestX_Select_H 				= 0;
+		DestY_Select_H 				= 0;
 
 
 		// Base address of the ARM lightweight bridge is hex FF200000. All registers are this addresss + Offset
@@ -263,8 +354,12 @@ module  GraphicsController_Verilog (
 			else if (AddressIn[7:1] == 7'b0000_010)	Y1_Select_H = 1;									// Y1 reg is at address offset 4
 			else if (AddressIn[7:1] == 7'b0000_011)	X2_Select_H = 1;									// X2 reg is at address offset 6
 			else if (AddressIn[7:1] == 7'b0000_100)	Y2_Select_H = 1;									// Y2 reg is at address offset 8
+			else if (AddressIn[7:1] == 7'b0000_101)	PixelData_Select_H = 1;							// PixelData reg is at address offset hex 0A
+			else if (AddressIn[7:1] == 7'b0000_110)	VSyncClear_Select_H = 1;						// VSyncClear reg is at address offset hex 0C
 			else if (AddressIn[7:1] == 7'b0000_111)	Colour_Select_H = 1;								// Colour reg is at address offset hex 0E
 			else if (AddressIn[7:1] == 7'b0001_000) 	BackGroundColour_Select_H = 1;				// Background colour reg at address offset hex 10
+			else if (AddressIn[7:1] == 7'b0001_001) 	DestX_Select_H = 1;								// DestX reg is at address offset hex 12
+			else if (AddressIn[7:1] == 7'b0001_010) 	DestY_Select_H = 1;								// DestY reg is at address offset hex 14
 		end
 	end
 	
@@ -284,9 +379,55 @@ module  GraphicsController_Verilog (
 		end
 	end	
 	
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This process sets PixelDataWritten_H to '1' when CPU writes to the PixelData register
+// The Blit states draw the pixel and clear it again, ready for the next one. A write to the command register
+// clears it too, so a pixel written when no Blit was running is not taken as the first pixel of the next one
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////	
+
+	always@(posedge Clk) begin
+		if(Reset_L == 0)
+			PixelDataWritten_H <= 0;
+		else begin
+			if(PixelData_Select_H == 1) 					// when CPU writes to PixelData register
+				PixelDataWritten_H <= 1;
+			else if(ClearPixelDataWritten_H == 1 || Command_Select_H == 1) 		// signal to clear the register, or a new command
+				PixelDataWritten_H <= 0;
+		end
+	end	
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// This process sets VSyncSeen_H to '1' at the start of every vertical sync from the LCD controller and
+// clears it when the CPU writes (anything) to the VSyncClear register, so the CPU can wait for the next
+// vertical sync without having to be reading the status register at the moment it starts.
+// VSync_L comes from the LCD controller's clock so it goes through two flip flops first
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////	
+
+	always@(posedge Clk) begin
+		if(Reset_L == 0) begin
+			VSync_Meta_L <= 1;
+			VSync_Sync_L <= 1;
+			VSync_Last_L <= 1;
+			VSyncSeen_H <= 0;
+		end
+		else begin
+			VSync_Meta_L <= VSync_L;
+			VSync_Sync_L <= VSync_Meta_L;
+			VSync_Last_L <= VSync_Sync_L;
+			
+			if(VSyncClear_Select_H == 1) 				// when CPU writes to VSyncClear register
+				VSyncSeen_H <= 0;
+			else if(VSync_Sync_L == 0 && VSync_Last_L == 1) 	// falling edge of VSync_L
+				VSyncSeen_H <= 1;
+		end
+	end	
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Read Status  -activated when CPU reads status reg of graphics chip
 // when bit 0 = 1, device is Idle and ready to receive command
+// when bit 1 = 1, the last pixel written to PixelData has not been drawn yet
+// when bit 2 = 1, the LCD controller is in vertical sync (part of vertical blanking)
+// when bit 3 = 1, a vertical sync has started since the CPU last wrote to VSyncClear
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	always@(*) begin
@@ -294,7 +435,7 @@ module  GraphicsController_Verilog (
 		
 		if(GraphicsCS_L == 0 && RW == 1 && AS_L == 0) begin 
 			if(AddressIn[15:1] == 15'b0) 										// read of status register at offset 0
-				DataOutToCPU = {15'b0, Idle_H};							   // leading 15 bits of 0 plus Idle status on bit 0
+				DataOutToCPU = {12'b0, VSyncSeen_H, ~VSync_Sync_L, PixelDataWritten_H, Idle_H};	// leading 12 bits of 0, then vertical sync status on bits 3 and 2, pixel data status on bit 1 plus Idle status on bit 0
 			else if(AddressIn[15:1] == 15'b0000_0000_0000_111) 		// read of colour register hex 0e/0f
 				DataOutToCPU = Colour_Latch ;
 		end
@@ -383,6 +524,36 @@ module  GraphicsController_Verilog (
 		end
 	end	
 	
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DestX and DestY process and register update (top left corner a CopyRect command copies to)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	always@(posedge Clk) begin
+		if(Reset_L == 0) begin
+			DestX <= 16'h0;							// for SIMULATION ONLY
+			DestY <= 16'h0;
+		end
+		else begin
+			if(DestX_Select_H == 1) begin
+				if(UDS_L == 0) 
+					DestX[15:8] <= DataInFromCPU[15:8];
+				if(LDS_L == 0) 
+					DestX[7:0] <= DataInFromCPU[7:0];
+			end
+			if(DestY_Select_H == 1) begin
+				if(UDS_L == 0) 
+					DestY[15:8] <= DataInFromCPU[15:8];
+				if(LDS_L == 0) 
+					DestY[7:0] <= DataInFromCPU[7:0];
+			end
+		end
+	end
+
+	// A copy to the right of (or below) where it comes from has to start at the right (or bottom) of the rectangle
+	// and work backwards, otherwise when the two overlap it would read pixels it has already overwritten
+	assign CopyLeft = (DestX > X1);
+	assign CopyUp = (DestY > Y1);
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Colour Reg process and update
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -437,6 +608,26 @@ module  GraphicsController_Verilog (
 		end 
 	end	
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PixelData register update
+//
+// During a Blit command the CPU writes the colour of each pixel of the rectangle here in turn, left to right
+// and top to bottom. Each write is drawn at the next position, so only one register write is needed per pixel
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	always@(posedge Clk) begin
+		if(Reset_L == 0) 
+			PixelData <= 16'h0;
+		else begin
+			if(PixelData_Select_H == 1) begin				
+				if(UDS_L == 0) 
+					PixelData[15:8] <= DataInFromCPU[15:8];
+				if(LDS_L == 0) 
+					PixelData[7:0] <= DataInFromCPU[7:0];
+			end
+		end 
+	end	
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Colour Latch process and register update (used for reading pixel)
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -536,6 +727,24 @@ module  GraphicsController_Verilog (
 			error <= error_Data; // update the register
 	end
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// end of the last line register update, and where a line starts: X1,Y1 or the end of the last line for a LineTo
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	always@(posedge Clk) begin
+		if(Reset_L == 0) begin
+			LastX2 <= 0;
+			LastY2 <= 0;
+		end
+		else if(LineEnd_Load_H == 1) begin // if load is active
+			LastX2 <= X2;
+			LastY2 <= Y2;
+		end
+	end
+
+	assign LineStartX = (Command == LineTo) ? LastX2 : X1;
+	assign LineStartY = (Command == LineTo) ? LastY2 : Y1;
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // i register update
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -599,6 +808,34 @@ module  GraphicsController_Verilog (
 			crit <= crit_Data; // update the register
 	end
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Octants register update
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	always@(posedge Clk) begin
+		if(Octants_Load_H == 1) // if load is active
+			Octants <= Octants_Data; // update the register
+	end
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ellipse register updates
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	always@(posedge Clk) begin
+		if(ellipse_a2_Load_H == 1)
+			ellipse_a2 <= ellipse_a2_Data;
+		if(ellipse_b2_Load_H == 1)
+			ellipse_b2 <= ellipse_b2_Data;
+		if(ellipse_dx_Load_H == 1)
+			ellipse_dx <= ellipse_dx_Data;
+		if(ellipse_dy_Load_H == 1)
+			ellipse_dy <= ellipse_dy_Data;
+		if(ellipse_d_Load_H == 1)
+			ellipse_d <= ellipse_d_Data;
+		if(ellipse_region2_Load_H == 1)
+			ellipse_region2 <= ellipse_region2_Data;
+	end
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //	State Machine Registers
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -645,6 +882,7 @@ module  GraphicsController_Verilog (
 		ClearBusy_H 						= 0;
 		SetBusy_H							= 0;
 		ClearCommandWritten_H			= 0;
+		ClearPixelDataWritten_H			= 0;
 		Sig_Busy_H							= 1;				// default is device is busy
 		
 		Colour_Latch_Load_H				= 0;
@@ -689,6 +927,8 @@ module  GraphicsController_Verilog (
 		i_Data <= 0;
 		i_Load_H <= 0;
 
+		LineEnd_Load_H <= 0;
+
 		// Defaults for circle drawing algorithm
 		centreX_Data <= 0;
 		centreX_Load_H <= 0;
@@ -705,6 +945,28 @@ module  GraphicsController_Verilog (
 		crit_Data <= 0;
 		crit_Load_H <= 0;
 
+		Octants_Data <= 0;
+		Octants_Load_H <= 0;
+
+		// Defaults for ellipse drawing algorithm
+		ellipse_a2_Data <= 0;
+		ellipse_a2_Load_H <= 0;
+
+		ellipse_b2_Data <= 0;
+		ellipse_b2_Load_H <= 0;
+
+		ellipse_dx_Data <= 0;
+		ellipse_dx_Load_H <= 0;
+
+		ellipse_dy_Data <= 0;
+		ellipse_dy_Load_H <= 0;
+
+		ellipse_d_Data <= 0;
+		ellipse_d_Load_H <= 0;
+
+		ellipse_region2_Data <= 0;
+		ellipse_region2_Load_H <= 0;
+
 		//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// IMPORTANT we have to define what the default NEXT state will be. In this case we the state machine
 		// will return to the IDLE state unless we override this with a different one
@@ -744,10 +1006,18 @@ module  GraphicsController_Verilog (
 				NextState = LoadCoordinates;	
 			else if(Command == Vline) 
 				NextState = LoadCoordinates;
-			else if(Command == ALine) 
+			else if(Command == FilledRect)
+				NextState = LoadCoordinates;
+			else if(Command == Blit)
+				NextState = LoadCoordinates;
+			else if(Command == ALine || Command == LineTo) 
 				NextState = DrawLine;
-			else if(Command == Circle)
+			else if(Command == Circle || Command == Arc)
 				NextState = DrawCircle;
+			else if(Command == Ellipse)
+				NextState = DrawEllipse;
+			else if(Command == CopyRect)
+				NextState = DrawCopy;
 				
 			// add other code to process any new commands here e.g. draw a circle if you decide to implement that
 			// or draw a rectangle etc
@@ -855,6 +1125,10 @@ module  GraphicsController_Verilog (
 				NextState <= DrawHLine;
 			else if (Command == Vline)
 				NextState <= DrawVline;
+			else if (Command == FilledRect)
+				NextState <= DrawFilledRect;
+			else if (Command == Blit)
+				NextState <= DrawBlit;
 		end
 		
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -901,15 +1175,192 @@ module  GraphicsController_Verilog (
 			end
 		end
 			
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawFilledRect) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This state fills every pixel from X1,Y1 up to (but not including) X2,Y2 one pixel per clock
+// X_line walks along the current row (Y_line) and goes back to X1 on the next row when it reaches X2
+// or the right hand edge of the screen, so a whole rectangle (or the screen) is one command
+
+			if (X1 >= X2 || Y_line >= Y2 || Y_line > MAX_Y)
+				NextState = Idle;
+			else if (X_line >= X2 || X_line > MAX_X) begin	// nothing left to draw on this row
+				X_line_Data <= X1;
+				Y_line_Data <= Y_line + 1'b1;
+				X_line_Load_H <= 1;
+				Y_line_Load_H <= 1;
+
+				NextState = DrawFilledRect;
+			end
+			else begin
+				if (!(X_line < MIN_X || Y_line < MIN_Y)) begin
+					Sig_AddressOut 	= {Y_line[8:0], X_line[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+					Sig_RW_Out			= 0;
+						
+					if(X_line[0] == 1'b0)										// if the address/pixel is an even numbered one
+						Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+					else
+						Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+				end
+
+				if (X_line + 1'b1 >= X2 || X_line + 1'b1 > MAX_X) begin	// last pixel on this row so start the next one
+					X_line_Data <= X1;
+					Y_line_Data <= Y_line + 1'b1;
+					Y_line_Load_H <= 1;
+				end
+				else
+					X_line_Data <= X_line + 1'b1;
+				X_line_Load_H <= 1;
+
+				NextState = DrawFilledRect;
+			end
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawBlit) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This state waits for the CPU to write each pixel of the rectangle X1,Y1 up to (but not including) X2,Y2 to the
+// PixelData register and draws it at X_line,Y_line, then moves on to the next pixel in the row, or the start of the next row.
+// Every pixel of the rectangle takes one write, but those off the screen are not drawn. Like Idle we wait for the
+// CPU to finish its write (AS_L back high) before using the data
+
+			if (X1 >= X2 || Y_line >= Y2)
+				NextState = Idle;
+			else if (PixelDataWritten_H == 1 && AS_L == 1) begin
+				ClearPixelDataWritten_H = 1;
+
+				if (!(X_line < MIN_X || X_line > MAX_X || Y_line < MIN_Y || Y_line > MAX_Y)) begin
+					Sig_AddressOut 	= {Y_line[8:0], X_line[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+					Sig_DataOut 		= {PixelData[7:0], PixelData[7:0]};
+					Sig_RW_Out			= 0;
+						
+					if(X_line[0] == 1'b0)										// if the address/pixel is an even numbered one
+						Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+					else
+						Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+				end
+
+				if (X_line + 1'b1 >= X2) begin						// last pixel on this row so start the next one
+					X_line_Data <= X1;
+					Y_line_Data <= Y_line + 1'b1;
+					Y_line_Load_H <= 1;
+				end
+				else
+					X_line_Data <= X_line + 1'b1;
+				X_line_Load_H <= 1;
+
+				NextState = DrawBlit;
+			end
+			else
+				NextState = DrawBlit;						// stay here until the CPU writes the next pixel
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawCopy) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This state starts a copy of the pixels from X1,Y1 up to (but not including) X2,Y2 to the same sized rectangle with
+// its top left corner at DestX,DestY. X_line,Y_line walk over the rectangle being copied from, starting in whichever
+// corner is furthest in the direction the rectangle is moving (see CopyLeft and CopyUp) so the two can overlap,
+// e.g. to scroll the screen. Each pixel is read like ReadPixel does and then written, 3 clocks a pixel
+
+			if (X1 >= X2 || Y1 >= Y2)
+				NextState = Idle;
+			else begin
+				if (CopyLeft)
+					X_line_Data <= X2 - 1'b1;
+				else
+					X_line_Data <= X1;
+
+				if (CopyUp)
+					Y_line_Data <= Y2 - 1'b1;
+				else
+					Y_line_Data <= Y1;
+
+				X_line_Load_H <= 1;
+				Y_line_Load_H <= 1;
+
+				NextState = DrawCopyRead;
+			end
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawCopyRead) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+			if (Y_line < Y1 || Y_line >= Y2)					// gone past the last row
+				NextState = Idle;
+			else begin
+				Sig_AddressOut 	= {Y_line[8:0], X_line[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+
+				Sig_UDS_Out_L 	= 0;														// enable read from  upper half of Sram data bus
+				Sig_LDS_Out_L 	= 0;
+
+				NextState = DrawCopyRead1;
+			end
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawCopyRead1)
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+			NextState = DrawCopyWrite;	// dummy state to allow signals to reach video ram frame buffer (see ReadPixel1)
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawCopyWrite) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// the sram is now outputting the two pixels read in DrawCopyRead. Write the one we want to the same place in the
+// rectangle being copied to, unless that is off the screen, then move on to the next pixel
+
+			CopyDestX = X_line + (DestX - X1);
+			CopyDestY = Y_line + (DestY - Y1);
+
+			if (!(CopyDestX < MIN_X || CopyDestX > MAX_X || CopyDestY < MIN_Y || CopyDestY > MAX_Y)) begin
+				Sig_AddressOut 	= {CopyDestY[8:0], CopyDestX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+				Sig_RW_Out			= 0;
+
+				if(X_line[0] == 1'b0)												// pixel read was the upper byte
+					Sig_DataOut 	= {SRam_DataIn[15:8], SRam_DataIn[15:8]};
+				else
+					Sig_DataOut 	= {SRam_DataIn[7:0], SRam_DataIn[7:0]};
+
+				if(CopyDestX[0] == 1'b0)										// if the address/pixel is an even numbered one
+					Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+				else
+					Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+			end
+
+			if (CopyLeft ? (X_line - 1'b1 < X1) : (X_line + 1'b1 >= X2)) begin		// last pixel on this row so start the next one
+				if (CopyLeft)
+					X_line_Data <= X2 - 1'b1;
+				else
+					X_line_Data <= X1;
+
+				if (CopyUp)
+					Y_line_Data <= Y_line - 1'b1;
+				else
+					Y_line_Data <= Y_line + 1'b1;
+				Y_line_Load_H <= 1;
+			end
+			else if (CopyLeft)
+				X_line_Data <= X_line - 1'b1;
+			else
+				X_line_Data <= X_line + 1'b1;
+			X_line_Load_H <= 1;
+
+			NextState = DrawCopyRead;
+		end
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		else if(CurrentState == DrawLine) begin
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////		
-			x_Data <= X1; // store X1 into x
-			y_Data <= Y1; // store Y1 into y
+			x_Data <= LineStartX; // store X1 (or the end of the last line for LineTo) into x
+			y_Data <= LineStartY; // store Y1 (or the end of the last line for LineTo) into y
 
 			// Store abs(x2-x1) into dx
 			// Store sign(x2-x1) into s1
-			x2Minusx1 = X2 - X1;
+			x2Minusx1 = X2 - LineStartX;
 			if (x2Minusx1 < 0) begin
 				dx_Data <= -x2Minusx1;
 				s1_Data <= -1;
@@ -923,7 +1374,7 @@ module  GraphicsController_Verilog (
 
 			// Store abs(y2-y1) into dy
 			// Store sign(y2-xy) into s2
-			y2Minusy1 = Y2 - Y1;
+			y2Minusy1 = Y2 - LineStartY;
 			if (y2Minusy1 < 0) begin
 				dy_Data <= -y2Minusy1;
 				s2_Data <= -1;
@@ -937,6 +1388,9 @@ module  GraphicsController_Verilog (
 
 			interchange_Data <= 0;
 
+			// the next LineTo starts where this line ends
+			LineEnd_Load_H <= 1;
+
 			// Set all the load enables for signals we set above
 			x_Load_H <= 1;
 			y_Load_H <= 1;
@@ -1061,6 +1515,7 @@ module  GraphicsController_Verilog (
 				offset_y_Data <= 0; // offset_y = 0
 				offset_x_Data <= X2; // ofset_x = radius
 				crit_Data <= 1 - X2; // crit = 1 - radiu
+				Octants_Data <= (Command == Arc) ? Y2[7:0] : 8'hFF;	// an arc draws only some octants
 
 				// set load enables
 				centreX_Load_H <= 1;
@@ -1069,6 +1524,7 @@ module  GraphicsController_Verilog (
 				offset_y_Load_H <= 1;
 				offset_x_Load_H <= 1;
 				crit_Load_H <= 1;
+				Octants_Load_H <= 1;
 
 				NextState = DrawCircleStartMainLoop;
 		end
@@ -1089,7 +1545,7 @@ module  GraphicsController_Verilog (
 				centreXPlusOffsetX = centreX + offset_x;
 				centreYPlusOffsetY = centreY + offset_y;
 
-				if(!(centreXPlusOffsetX < MIN_X || centreXPlusOffsetX > MAX_X || centreYPlusOffsetY < MIN_Y || centreYPlusOffsetY > MAX_Y)) begin
+				if(Octants[0] == 1 && !(centreXPlusOffsetX < MIN_X || centreXPlusOffsetX > MAX_X || centreYPlusOffsetY < MIN_Y || centreYPlusOffsetY > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYPlusOffsetY[8:0], centreXPlusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1108,7 +1564,7 @@ module  GraphicsController_Verilog (
 				centreXPlusOffsetY = centreX + offset_y;
 				centreYPlusOffsetX = centreY + offset_x;
 
-				if(!(centreXPlusOffsetY < MIN_X || centreXPlusOffsetY > MAX_X || centreYPlusOffsetX < MIN_Y || centreYPlusOffsetX > MAX_Y)) begin
+				if(Octants[1] == 1 && !(centreXPlusOffsetY < MIN_X || centreXPlusOffsetY > MAX_X || centreYPlusOffsetX < MIN_Y || centreYPlusOffsetX > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYPlusOffsetX[8:0], centreXPlusOffsetY[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1127,7 +1583,7 @@ module  GraphicsController_Verilog (
 				centreXMinusOffsetX = centreX - offset_x;
 				centreYPlusOffsetY = centreY + offset_y;
 
-				if(!(centreXMinusOffsetX < MIN_X || centreXMinusOffsetX > MAX_X || centreYPlusOffsetY < MIN_Y || centreYPlusOffsetY > MAX_Y)) begin
+				if(Octants[3] == 1 && !(centreXMinusOffsetX < MIN_X || centreXMinusOffsetX > MAX_X || centreYPlusOffsetY < MIN_Y || centreYPlusOffsetY > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYPlusOffsetY[8:0], centreXMinusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1146,7 +1602,7 @@ module  GraphicsController_Verilog (
 				centreXMinusOffsetY = centreX - offset_y;
 				centreYPlusOffsetX = centreY + offset_x;
 
-				if(!(centreXMinusOffsetY < MIN_X || centreXMinusOffsetY > MAX_X || centreYPlusOffsetX < MIN_Y || centreYPlusOffsetX > MAX_Y)) begin
+				if(Octants[2] == 1 && !(centreXMinusOffsetY < MIN_X || centreXMinusOffsetY > MAX_X || centreYPlusOffsetX < MIN_Y || centreYPlusOffsetX > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYPlusOffsetX[8:0], centreXMinusOffsetY[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1165,7 +1621,7 @@ module  GraphicsController_Verilog (
 				centreXMinusOffsetX = centreX - offset_x;
 				centreYMinusOffsetY = centreY - offset_y;
 
-				if(!(centreXMinusOffsetX < MIN_X || centreXMinusOffsetX > MAX_X || centreYMinusOffsetY < MIN_Y || centreYMinusOffsetY > MAX_Y)) begin
+				if(Octants[4] == 1 && !(centreXMinusOffsetX < MIN_X || centreXMinusOffsetX > MAX_X || centreYMinusOffsetY < MIN_Y || centreYMinusOffsetY > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYMinusOffsetY[8:0], centreXMinusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1184,7 +1640,7 @@ module  GraphicsController_Verilog (
 				centreXMinusOffsetY = centreX - offset_y;
 				centreYMinusOffsetX = centreY - offset_x;
 
-				if(!(centreXMinusOffsetY < MIN_X || centreXMinusOffsetY > MAX_X || centreYMinusOffsetX < MIN_Y || centreYMinusOffsetX > MAX_Y)) begin
+				if(Octants[5] == 1 && !(centreXMinusOffsetY < MIN_X || centreXMinusOffsetY > MAX_X || centreYMinusOffsetX < MIN_Y || centreYMinusOffsetX > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYMinusOffsetX[8:0], centreXMinusOffsetY[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1203,7 +1659,7 @@ module  GraphicsController_Verilog (
 				centreXPlusOffsetX = centreX + offset_x;
 				centreYMinusOffsetY = centreY - offset_y;
 
-				if(!(centreXPlusOffsetX < MIN_X || centreXPlusOffsetX > MAX_X || centreYMinusOffsetY < MIN_Y || centreYMinusOffsetY > MAX_Y)) begin
+				if(Octants[7] == 1 && !(centreXPlusOffsetX < MIN_X || centreXPlusOffsetX > MAX_X || centreYMinusOffsetY < MIN_Y || centreYMinusOffsetY > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYMinusOffsetY[8:0], centreXPlusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1222,7 +1678,7 @@ module  GraphicsController_Verilog (
 				centreXPlusOffsetY = centreX + offset_y;
 				centreYMinusOffsetX = centreY - offset_x;
 
-				if(!(centreXPlusOffsetY < MIN_X || centreXPlusOffsetY > MAX_X || centreYMinusOffsetX < MIN_Y || centreYMinusOffsetX > MAX_Y)) begin
+				if(Octants[6] == 1 && !(centreXPlusOffsetY < MIN_X || centreXPlusOffsetY > MAX_X || centreYMinusOffsetX < MIN_Y || centreYMinusOffsetX > MAX_Y)) begin
 					Sig_AddressOut 	= {centreYMinusOffsetX[8:0], centreXPlusOffsetY[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
 					Sig_RW_Out			= 0;
 						
@@ -1268,6 +1724,213 @@ module  GraphicsController_Verilog (
 				NextState = DrawCircleStartMainLoop;
 		end
 
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipse) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Midpoint ellipse: starting at the bottom (offset_x = 0, offset_y = Y radius) step offset_x along while
+// the ellipse is flatter than 45 degrees (region 1), then step offset_y down to 0 (region 2), drawing the
+// point in all 4 quadrants each step. ellipse_d is 4 times how far outside the ellipse the midpoint
+// between the two pixels that could be drawn next is
+
+				centreX_Data <= X1;
+				centreY_Data <= Y1;
+				offset_x_Data <= 0;
+				offset_y_Data <= Y2;
+				ellipse_a2_Data <= X2 * X2;
+				ellipse_b2_Data <= Y2 * Y2;
+				ellipse_region2_Data <= 0;
+
+				// set load enables
+				centreX_Load_H <= 1;
+				centreY_Load_H <= 1;
+				offset_x_Load_H <= 1;
+				offset_y_Load_H <= 1;
+				ellipse_a2_Load_H <= 1;
+				ellipse_b2_Load_H <= 1;
+				ellipse_region2_Load_H <= 1;
+
+				NextState = DrawEllipse1;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipse1) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				ellipse_dx_Data <= 0;
+				ellipse_dy_Data <= 2 * ellipse_a2 * offset_y;
+				ellipse_d_Data <= 4 * ellipse_b2 - 4 * ellipse_a2 * offset_y + ellipse_a2;	// 4 * (b2 - a2 * b + a2 / 4)
+
+				ellipse_dx_Load_H <= 1;
+				ellipse_dy_Load_H <= 1;
+				ellipse_d_Load_H <= 1;
+
+				NextState = DrawEllipseStartRegion1;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseStartRegion1) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				if (ellipse_dx >= ellipse_dy)
+					NextState = DrawEllipseRegion2;
+				else
+					NextState = DrawEllipseQuadrant1;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseQuadrant1) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				centreXPlusOffsetX = centreX + offset_x;
+				centreYPlusOffsetY = centreY + offset_y;
+
+				if(!(centreXPlusOffsetX < MIN_X || centreXPlusOffsetX > MAX_X || centreYPlusOffsetY < MIN_Y || centreYPlusOffsetY > MAX_Y)) begin
+					Sig_AddressOut 	= {centreYPlusOffsetY[8:0], centreXPlusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+					Sig_RW_Out			= 0;
+
+					if(centreXPlusOffsetX[0] == 1'b0)										// if the address/pixel is an even numbered one
+						Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+					else
+						Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+				end
+
+				NextState = DrawEllipseQuadrant2;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseQuadrant2) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				centreXMinusOffsetX = centreX - offset_x;
+				centreYPlusOffsetY = centreY + offset_y;
+
+				if(!(centreXMinusOffsetX < MIN_X || centreXMinusOffsetX > MAX_X || centreYPlusOffsetY < MIN_Y || centreYPlusOffsetY > MAX_Y)) begin
+					Sig_AddressOut 	= {centreYPlusOffsetY[8:0], centreXMinusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+					Sig_RW_Out			= 0;
+
+					if(centreXMinusOffsetX[0] == 1'b0)										// if the address/pixel is an even numbered one
+						Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+					else
+						Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+				end
+
+				NextState = DrawEllipseQuadrant3;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseQuadrant3) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				centreXMinusOffsetX = centreX - offset_x;
+				centreYMinusOffsetY = centreY - offset_y;
+
+				if(!(centreXMinusOffsetX < MIN_X || centreXMinusOffsetX > MAX_X || centreYMinusOffsetY < MIN_Y || centreYMinusOffsetY > MAX_Y)) begin
+					Sig_AddressOut 	= {centreYMinusOffsetY[8:0], centreXMinusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+					Sig_RW_Out			= 0;
+
+					if(centreXMinusOffsetX[0] == 1'b0)										// if the address/pixel is an even numbered one
+						Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+					else
+						Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+				end
+
+				NextState = DrawEllipseQuadrant4;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseQuadrant4) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				centreXPlusOffsetX = centreX + offset_x;
+				centreYMinusOffsetY = centreY - offset_y;
+
+				if(!(centreXPlusOffsetX < MIN_X || centreXPlusOffsetX > MAX_X || centreYMinusOffsetY < MIN_Y || centreYMinusOffsetY > MAX_Y)) begin
+					Sig_AddressOut 	= {centreYMinusOffsetY[8:0], centreXPlusOffsetX[9:1]};		// 8 bit X address even though it goes up to 1024 which would mean 10 bits, because each address = 2 pixles/bytes
+					Sig_RW_Out			= 0;
+
+					if(centreXPlusOffsetX[0] == 1'b0)										// if the address/pixel is an even numbered one
+						Sig_UDS_Out_L 	= 0;								// enable write to upper half of Sram data bus
+					else
+						Sig_LDS_Out_L 	= 0;								// else write to lower half of Sram data bus
+				end
+
+				if (ellipse_region2 == 1)
+					NextState = DrawEllipseStepRegion2;
+				else
+					NextState = DrawEllipseStepRegion1;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseStepRegion1) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				// one pixel along, and one up too if the midpoint was outside the ellipse
+				ellipse_dx_next = ellipse_dx + 2 * ellipse_b2;
+				offset_x_Data <= offset_x + 1'b1;
+				ellipse_dx_Data <= ellipse_dx_next;
+
+				if (ellipse_d < 0) begin
+					ellipse_d_Data <= ellipse_d + 4 * (ellipse_dx_next + ellipse_b2);
+				end else begin
+					ellipse_dy_next = ellipse_dy - 2 * ellipse_a2;
+					offset_y_Data <= offset_y - 1'b1;
+					ellipse_dy_Data <= ellipse_dy_next;
+					ellipse_d_Data <= ellipse_d + 4 * (ellipse_dx_next - ellipse_dy_next + ellipse_b2);
+
+					offset_y_Load_H <= 1;
+					ellipse_dy_Load_H <= 1;
+				end
+
+				offset_x_Load_H <= 1;
+				ellipse_dx_Load_H <= 1;
+				ellipse_d_Load_H <= 1;
+
+				NextState = DrawEllipseStartRegion1;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseRegion2) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				// move ellipse_d from the midpoint beside the next pixel to the one above it
+				ellipse_d_Data <= ellipse_d + 3 * (ellipse_a2 - ellipse_b2) - 2 * (ellipse_dx + ellipse_dy);
+				ellipse_region2_Data <= 1;
+
+				ellipse_d_Load_H <= 1;
+				ellipse_region2_Load_H <= 1;
+
+				NextState = DrawEllipseStartRegion2;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseStartRegion2) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				if (offset_y < 0)
+					NextState = Idle;
+				else
+					NextState = DrawEllipseQuadrant1;
+		end
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		else if(CurrentState == DrawEllipseStepRegion2) begin
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+				// one pixel up, and one along too if the midpoint was inside the ellipse
+				ellipse_dy_next = ellipse_dy - 2 * ellipse_a2;
+				offset_y_Data <= offset_y - 1'b1;
+				ellipse_dy_Data <= ellipse_dy_next;
+
+				if (ellipse_d > 0) begin
+					ellipse_d_Data <= ellipse_d + 4 * (ellipse_a2 - ellipse_dy_next);
+				end else begin
+					ellipse_dx_next = ellipse_dx + 2 * ellipse_b2;
+					offset_x_Data <= offset_x + 1'b1;
+					ellipse_dx_Data <= ellipse_dx_next;
+					ellipse_d_Data <= ellipse_d + 4 * (ellipse_dx_next - ellipse_dy_next + ellipse_a2);
+
+					offset_x_Load_H <= 1;
+					ellipse_dx_Load_H <= 1;
+				end
+
+				offset_y_Load_H <= 1;
+				ellipse_dy_Load_H <= 1;
+				ellipse_d_Load_H <= 1;
+
+				NextState = DrawEllipseStartRegion2;
+		end
 	end
 endmodule
 
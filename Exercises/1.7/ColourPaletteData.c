@@ -0,0 +1,266 @@
+/*****************************************************************************************
+** 24 bit RGB values pre-programmed into the 256 entry colour palette of the graphics chip
+** (copied from ColourPallette_2PortRam.mif in the Quartus project).
+**
+** The palette in the hardware cannot be read back, so code running on the host that wants
+** to turn palette numbers into real colours (e.g. to write an image file) uses this table
+*****************************************************************************************/
+
+const int ColourPaletteData[256] = {
+    0x000000,    // 0 Black
+    0xFFFFFF,    // 1 White
+    0xFF0000,    // 2 Red
+    0x00FF00,    // 3 Green/Lime
+    0x0000FF,    // 4 Blue
+    0xFFFF00,    // 5 Yellow
+    0x00FFFF,    // 6 Cyan
+    0xFF00FF,    // 7 Magenta
+    0xC0C0C0,    // 8 Silver
+    0x808080,    // 9 Gray
+    0x800000,    // 10 Maroon
+    0x808000,    // 11 Olive
+    0x008000,    // 12 DarkGreen
+    0x800080,    // 13 Purple
+    0x008080,    // 14 Teal
+    0x000080,    // 15 Navy
+    0x8B0000,    // 16 Dark Red
+    0xA52A2A,    // 17 Brown
+    0xB22222,    // 18 FireBrick
+    0xDC143C,    // 19 Crimson
+    0xFF6347,    // 20 Tomato
+    0xFF7F50,    // 21 Coral
+    0xCD5C5C,    // 22 Indian Red
+    0xF08080,    // 23 Light Coral
+    0xE9967A,    // 24 Dark Salmon
+    0xFA8072,    // 25 Salmon
+    0xFFA07A,    // 26 Light Salmon
+    0xFF4500,    // 27 Orange Red
+    0xFF8C00,    // 28 Dark Orange
+    0xFFA500,    // 29 Orange
+    0xFFD700,    // 30 Gold
+    0xB8860B,    // 31 Dark Golden Rod
+    0xDAA520,    // 32 Golden Rod
+    0xEEE8AA,    // 33 Pale Golden Rod
+    0xBDB76B,    // 34 Dark Kharki
+    0xF0E68C,    // 35 Khaki
+    0x808000,    // 36 Olive
+    0xFFFF00,    // 37 Yellow
+    0x9ACD32,    // 38 Yellow Green
+    0x556B2F,    // 39 Dark Olive Green
+    0x6B8E23,    // 40 Olive Drab
+    0x7CFC00,    // 41 Lawn Green
+    0x7FFF00,    // 42 Chart Reuse
+    0xADFF2F,    // 43 Green Yellow
+    0x006400,    // 44 Dark Green
+    0x008000,    // 45 Green
+    0x228B22,    // 46 Forest Green
+    0x00FF00,    // 47 Green/Lime
+    0x32CD32,    // 48 Lime Green
+    0x90EE90,    // 49 Light Green
+    0x98FB98,    // 50 Pale Green
+    0x8FBC8F,    // 51 Dark See Green
+    0x00FA9A,    // 52 Medium Spring Green
+    0x00FF7F,    // 53 Spring Green
+    0x2E8B57,    // 54 Sea Green
+    0x66CDAA,    // 55 Medium Aqua Marine
+    0x3CB371,    // 56 Medium Sea Green
+    0x20B2AA,    // 57 Light Sea Green
+    0x2F4F4F,    // 58 Dark Slate Gray
+    0x008080,    // 59 Teal
+    0x008B8B,    // 60 Dark Cyan
+    0x00FFFF,    // 61 Aqua/Cyan
+    0xE0FFFF,    // 62 Light Cyan
+    0x00CED1,    // 63 Dark Turquise
+    0x40E0D0,    // 64 Turquoise
+    0x48D1CC,    // 65 Medium Turquoise
+    0xAFEEEE,    // 66 Pale Turquoise
+    0x7FFFD4,    // 67 Aqua Marine
+    0xB0E0E6,    // 68 Powder Blue
+    0x5F9EA0,    // 69 Cadet Blue
+    0x4682B4,    // 70 Steel Blue
+    0x6495ED,    // 71 Corn Flower Blue
+    0x00BFFF,    // 72 Deep Sky Blue
+    0x1E90FF,    // 73 Dodger Blue
+    0xADD8E6,    // 74 Light Blue
+    0x87CEEB,    // 75 Sky Blue
+    0x87CEFA,    // 76 Light Sky Blue
+    0x191970,    // 77 Midnight Blue
+    0x000080,    // 78 Navy
+    0x00008B,    // 79 Bark Blue
+    0x0000CD,    // 80 Medium Blue
+    0x0000FF,    // 81 Blue
+    0x4169E1,    // 82 Royal Blue
+    0x8A2BE2,    // 83 Blue Violet
+    0x4B0082,    // 84 Indigo
+    0x483D8B,    // 85 Dark Slate Blue
+    0x6A5ACD,    // 86 Slate Blue
+    0x7B68EE,    // 87 Medium Slate Blue
+    0x9370DB,    // 88 Medium Purple
+    0x8B008B,    // 89 Dark Magenta
+    0x9400D3,    // 90 Dark Violet
+    0x9932CC,    // 91 Dark Orchid"
+    0xBA55D3,    // 92 Medium Orchid
+    0x800080,    // 93 Purple
+    0xD8BFD8,    // 94 Thistle
+    0xDDA0DD,    // 95 Plum
+    0xEE82EE,    // 96 Violet
+    0xFF00FF,    // 97 Magenta/Fuchia
+    0xDA70D6,    // 98 Orchid
+    0xC71585,    // 99 Medium Violet Red
+    0xDB7093,    // 100 Pale Violet Red
+    0xFF1493,    // 101 Deep Pink
+    0xFF69B4,    // 102 Hot Pink
+    0xFFB6C1,    // 103 Light Pink
+    0xFFC0CB,    // 104 Pink
+    0xFAEBD7,    // 105 Antique White
+    0xF5F5DC,    // 106 Beige
+    0xFFE4C4,    // 107 Bisque
+    0xFFEBCD,    // 108 Blanched Almond
+    0xF5DEB3,    // 109 Wheat
+    0xFFF8DC,    // 110 Corn Silk
+    0xFFFACD,    // 111 Lemon Chiffon
+    0xFAFAD2,    // 112 Light Golden Rod Yellow
+    0xFFFFE0,    // 113 Light Yellow
+    0x8B4513,    // 114 Saddle Brown
+    0xA0522D,    // 115 Sienna
+    0xD2691E,    // 116 Chocolate
+    0xCD853F,    // 117 Peru
+    0xF4A460,    // 118 Sandy Brown
+    0xDEB887,    // 119 Burley Wood
+    0xD2B48C,    // 120 Tan
+    0xBC8F8F,    // 121 Rosy Tan
+    0xFFE4B5,    // 122 Moccasin
+    0xFFDEAD,    // 123 Navajo White
+    0xFFDAB9,    // 124 Peach Puff
+    0xFFE4E1,    // 125 Misty Rose
+    0xFFF0F5,    // 126 Lavendar Blush
+    0xFAF0E6,    // 127 Linen
+    0xFDF5E6,    // 128 Old Lace
+    0xFFEFD5,    // 129 Papaya Whip
+    0xFFF5EE,    // 130 Sea Shell
+    0xF5FFFA,    // 131 Mint Cream
+    0x708090,    // 132 Slate Gray
+    0x778899,    // 133 Light Slate Gray
+    0xB0C4DE,    // 134 Light Steel Blue
+    0xE6E6FA,    // 135 Lavender
+    0xFFFAF0,    // 136 Floral White
+    0xF0F8FF,    // 137 Alice Blue
+    0xF8F8FF,    // 138 Ghost White
+    0xF0FFF0,    // 139 Honey Dew
+    0xFFFFF0,    // 140 Ivory
+    0xF0FFFF,    // 141 Azure
+    0xFFFAFA,    // 142 Snow
+    0x000000,    // 143 Black
+    0x696969,    // 144 Dim Gray
+    0x808080,    // 145 Gray
+    0xA9A9A9,    // 146 Dark Gray
+    0xD3D3D3,    // 147 Light Gray
+    0xDCDCDC,    // 148 GainsBoro
+    0xF5F5F5,    // 149 White Smoke
+    0xFFFFFF,    // 150 White
+    0x000000,    // 151 Black
+    0xFFFFFF,    // 152 White
+    0xFF0000,    // 153 Red
+    0x00FF00,    // 154 Green/Lime
+    0x0000FF,    // 155 Blue
+    0xFFFF00,    // 156 Yellow
+    0x00FFFF,    // 157 Cyan
+    0xFF00FF,    // 158 Magenta
+    0xC0C0C0,    // 159 Silver
+    0x808080,    // 160 Gray
+    0x800000,    // 161 Maroon
+    0x808000,    // 162 Olive
+    0x008000,    // 163 DarkGreen
+    0x800080,    // 164 Purple
+    0x008080,    // 165 Teal
+    0x000080,    // 166 Navy
+    0x8B0000,    // 167 Dark Red
+    0xA52A2A,    // 168 Brown
+    0xB22222,    // 169 FireBrick
+    0xDC143C,    // 170 Crimson
+    0xFF6347,    // 171 Tomato
+    0xFF7F50,    // 172 Coral
+    0xCD5C5C,    // 173 Indian Red
+    0xF08080,    // 174 Light Coral
+    0xE9967A,    // 175 Dark Salmon
+    0xFA8072,    // 176 Salmon
+    0xFFA07A,    // 177 Light Salmon
+    0xFF4500,    // 178 Orange Red
+    0xFF8C00,    // 179 Dark Orange
+    0xFFA500,    // 180 Orange
+    0xFFD700,    // 181 Gold
+    0xB8860B,    // 182 Dark Golden Rod
+    0xDAA520,    // 183 Golden Rod
+    0xEEE8AA,    // 184 Pale Golden Rod
+    0xBDB76B,    // 185 Dark Kharki
+    0xF0E68C,    // 186 Khaki
+    0x808000,    // 187 Olive
+    0xFFFF00,    // 188 Yellow
+    0x9ACD32,    // 189 Yellow Green
+    0x556B2F,    // 190 Dark Olive Green
+    0x6B8E23,    // 191 Olive Drab
+    0x7CFC00,    // 192 Lawn Green
+    0x7FFF00,    // 193 Chart Reuse
+    0xADFF2F,    // 194 Green Yellow
+    0x006400,    // 195 Dark Green
+    0x008000,    // 196 Green
+    0x228B22,    // 197 Forest Green
+    0x00FF00,    // 198 Green/Lime
+    0x32CD32,    // 199 Lime Green
+    0x90EE90,    // 200 Light Green
+    0x98FB98,    // 201 Pale Green
+    0x8FBC8F,    // 202 Dark See Green
+    0x00FA9A,    // 203 Medium Spring Green
+    0x00FF7F,    // 204 Spring Green
+    0x2E8B57,    // 205 Sea Green
+    0x66CDAA,    // 206 Medium Aqua Marine
+    0x3CB371,    // 207 Medium Sea Green
+    0x20B2AA,    // 208 Light Sea Green
+    0x2F4F4F,    // 209 Dark Slate Gray
+    0x008080,    // 210 Teal
+    0x008B8B,    // 211 Dark Cyan
+    0x00FFFF,    // 212 Aqua/Cyan
+    0xE0FFFF,    // 213 Light Cyan
+    0x00CED1,    // 214 Dark Turquise
+    0x40E0D0,    // 215 Turquoise
+    0x48D1CC,    // 216 Medium Turquoise
+    0xAFEEEE,    // 217 Pale Turquoise
+    0x7FFFD4,    // 218 Aqua Marine
+    0xB0E0E6,    // 219 Powder Blue
+    0x5F9EA0,    // 220 Cadet Blue
+    0x4682B4,    // 221 Steel Blue
+    0x6495ED,    // 222 Corn Flower Blue
+    0x00BFFF,    // 223 Deep Sky Blue
+    0x1E90FF,    // 224 Dodger Blue
+    0xADD8E6,    // 225 Light Blue
+    0x87CEEB,    // 226 Sky Blue
+    0x87CEFA,    // 227 Light Sky Blue
+    0x191970,    // 228 Midnight Blue
+    0x000080,    // 229 Navy
+    0x00008B,    // 230 Bark Blue
+    0x0000CD,    // 231 Medium Blue
+    0x0000FF,    // 232 Blue
+    0x4169E1,    // 233 Royal Blue
+    0x8A2BE2,    // 234 Blue Violet
+    0x4B0082,    // 235 Indigo
+    0x483D8B,    // 236 Dark Slate Blue
+    0x6A5ACD,    // 237 Slate Blue
+    0x7B68EE,    // 238 Medium Slate Blue
+    0x9370DB,    // 239 Medium Purple
+    0x8B008B,    // 240 Dark Magenta
+    0x9400D3,    // 241 Dark Violet
+    0x9932CC,    // 242 Dark Orchid
+    0xBA55D3,    // 243 Medium Orchid
+    0x800080,    // 244 Purple
+    0xD8BFD8,    // 245 Thistle
+    0xDDA0DD,    // 246 Plum
+    0xEE82EE,    // 247 Violet
+    0xFF00FF,    // 248 Magenta/Fuchia
+    0xDA70D6,    // 249 Orchid
+    0xC71585,    // 250 Medium Violet Red
+    0xDB7093,    // 251 Pale Violet Red
+    0xFF1493,    // 252 Deep Pink
+    0xFF69B4,    // 253 Hot Pink
+    0xFFB6C1,    // 254 Light Pink
+    0xFFC0CB     // 255 Pink
+};
@@ -0,0 +1,374 @@
+#include "Graphics.h"
+
+// what was last written to the graphics chip's registers by GRAPHICS_WRITE, -1 if not known yet
+GraphicsRegisterValues GraphicsRegisters = { -1, -1, -1, -1, -1, -1, -1 };
+unsigned long GraphicsElidedWrites = 0;     // writes left out because the register already held the value
+
+// Write all the registers next time, e.g. after the graphics chip has been reset
+void GraphicsForgetRegisters(void)
+{
+    GraphicsRegisters.X1 = -1;
+    GraphicsRegisters.Y1 = -1;
+    GraphicsRegisters.X2 = -1;
+    GraphicsRegisters.Y2 = -1;
+    GraphicsRegisters.Colour = -1;
+    GraphicsRegisters.DestX = -1;
+    GraphicsRegisters.DestY = -1;
+}
+
+/*******************************************************************************************
+* This function writes a single pixel to the x,y coords specified using the specified colour
+* Note colour is a byte and represents a palette number (0-255) not a 24 bit RGB value
+********************************************************************************************/
+void WriteAPixel(int x, int y, int Colour)
+{
+    // the graphics chip does not clip pixels itself
+    if (!ClipPixel(x, y)) {
+        return;
+    }
+    BACK_BUFFER_COMMAND(PutAPixel, x, y, 0, 0, Colour);
+
+	WAIT_FOR_GRAPHICS;				// is graphics ready for new command
+
+	GRAPHICS_WRITE(X1, x);				// write coords to x1, y1
+	GRAPHICS_WRITE(Y1, y);
+	GRAPHICS_WRITE(Colour, Colour);			// set pixel colour
+	GraphicsCommandReg = PutAPixel;			// give graphics "write pixel" command
+	PROFILE_COMMAND(PutAPixel, 4);
+	SHADOW_COMMAND(PutAPixel, x, y, 0, 0, Colour);
+}
+
+/*********************************************************************************************
+* This function read a single pixel from the x,y coords specified and returns its colour
+* Note returned colour is a byte and represents a palette number (0-255) not a 24 bit RGB value
+* If the shadow frame buffer is on (GraphicsShadow.c) the pixel comes from there without waiting
+* for the graphics chip
+*********************************************************************************************/
+
+int ReadAPixel(int x, int y)
+{
+	if (GraphicsShadowEnabled) {
+		return GraphicsShadow[y & 0x1FF][x & 0x3FF];
+	}
+	return ReadAPixelFromGraphics(x, y);
+}
+
+// Read a pixel back from the frame buffer with a "get pixel" command, ignoring the shadow
+int ReadAPixelFromGraphics(int x, int y)
+{
+	WAIT_FOR_GRAPHICS;			// is graphics ready for new command
+
+	GRAPHICS_WRITE(X1, x);			// write coords to x1, y1
+	GRAPHICS_WRITE(Y1, y);
+	GraphicsCommandReg = GetAPixel;		// give graphics a "get pixel" command
+	PROFILE_COMMAND(GetAPixel, 3);
+
+	WAIT_FOR_GRAPHICS;			// is graphics done reading pixel
+	return (int)(GraphicsColourLatchReg) ;	// return the palette number (colour)
+}
+
+
+/**********************************************************************************
+** subroutine to program a hardware (graphics chip) palette number with an RGB value
+** e.g. ProgramPalette(RED, 0x00FF0000) ;
+**
+************************************************************************************/
+
+void ProgramPalette(int PaletteNumber, int RGB)
+{
+    WAIT_FOR_GRAPHICS;
+    GRAPHICS_WRITE(Colour, PaletteNumber);
+    GRAPHICS_WRITE(X1, RGB >> 16);             // program red value in ls.8 bit of X1 reg
+    GRAPHICS_WRITE(Y1, RGB);                   // program green and blue into ls 16 bit of Y1 reg
+    GraphicsCommandReg = ProgramPaletteColour; // issue command
+    PROFILE_COMMAND(ProgramPaletteColour, 4);
+    RememberPaletteColour(PaletteNumber, RGB);
+}
+
+// Draw a horizontal line from (x1,y1) to (x1+length-1, y1) of colour Colour
+void HLine(int x1, int y1, int length, int Colour)
+{
+	int x2 = x1 + length; // We don't write to coordinate (x2,y1), but use it as a stopping point instead
+
+    if (!ClipSpan(&x1, &x2, y1)) {
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawHLine, x1, y1, x2, y1, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, x1);                 // write coords to x1, y1, and x2, y2
+    GRAPHICS_WRITE(Y1, y1);
+    GRAPHICS_WRITE(X2, x2);
+    GRAPHICS_WRITE(Y2, y1);
+    GRAPHICS_WRITE(Colour, Colour);         // set pixel colour
+    GraphicsCommandReg = DrawHLine;         // give graphics "draw horizontal line" command
+    PROFILE_COMMAND(DrawHLine, 6);
+    SHADOW_COMMAND(DrawHLine, x1, y1, x2, y1, Colour);
+}
+
+// Draw a vertical line from (x1,y1) to (x1, y1+length-1) of colour Colour
+void VLine(int x1, int y1, int length, int Colour)
+{
+    int y2 = y1 + length; // We don't write to coordinate (x1,y2), but use it as a stopping point instead
+
+    if (!ClipVSpan(x1, &y1, &y2)) {
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawVLine, x1, y1, x1, y2, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, x1);                 // write coords to x1, y1, and x2, y2
+    GRAPHICS_WRITE(Y1, y1);
+    GRAPHICS_WRITE(X2, x1);
+    GRAPHICS_WRITE(Y2, y2);
+    GRAPHICS_WRITE(Colour, Colour);         // set pixel colour
+    GraphicsCommandReg = DrawVLine;         // give graphics "draw vertical line" command
+    PROFILE_COMMAND(DrawVLine, 6);
+    SHADOW_COMMAND(DrawVLine, x1, y1, x1, y2, Colour);
+}
+
+// Draw a line from (x1,y1) to (x2,y2) of colour Colour
+void Line(int x1, int y1, int x2, int y2, int Colour)
+{
+    int Clip = ClipLine(x1, y1, x2, y2);
+
+    if (Clip == CLIP_REJECT) {
+        return;
+    }
+    if (Clip == CLIP_PARTIAL) {
+        ClippedLine(x1, y1, x2, y2, Colour);
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawLine, x1, y1, x2, y2, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, x1);                // write coords to x1, y1, and x2, y2
+    GRAPHICS_WRITE(Y1, y1);
+    GRAPHICS_WRITE(X2, x2);
+    GRAPHICS_WRITE(Y2, y2);
+    GRAPHICS_WRITE(Colour, Colour);        // set pixel colour
+    GraphicsCommandReg = DrawLine;         // give graphics "draw line" command
+    PROFILE_COMMAND(DrawLine, 6);
+    SHADOW_COMMAND(DrawLine, x1, y1, x2, y2, Colour);
+}
+
+// Draw a triangle of colour Colour that connects points (x1,y1), (x2,y2), and (x3, y3)
+void Triangle(int x1, int y1, int x2, int y2, int x3, int y3, int Colour)
+{
+    Line(x1, y1, x2, y2, Colour);
+    Line(x2, y2, x3, y3, Colour);
+    Line(x3, y3, x1, y1, Colour);
+}
+
+// Draw a rectangle of colour Colour with a top left coordinate of (x1,y1) that is width pixels wide and height pixels tall
+// The rectangle will be empty instead of filled
+void Rectangle(int x1, int y1, int width, int height, int Colour)
+{
+    HLine(x1, y1, width, Colour);
+    HLine(x1, y1+height-1, width, Colour);
+    VLine(x1, y1, height, Colour);
+    VLine(x1+width-1, y1, height, Colour);
+}
+
+// Draw a rectangle of colour Colour with a top left coordinate of (x1,y1) that is width pixels wide and height pixels tall
+// The rectangle will be filled, instead of being empty
+void FilledRectangle(int x1, int y1, int width, int height, int Colour)
+{
+    int x2 = x1 + width;            // We don't write to column x2 or row y2, they are stopping points
+    int y2 = y1 + height;
+
+    if (!ClipBox(&x1, &y1, &x2, &y2)) {
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawFilledRect, x1, y1, x2, y2, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, x1);                      // write coords to x1, y1, and x2, y2
+    GRAPHICS_WRITE(Y1, y1);
+    GRAPHICS_WRITE(X2, x2);
+    GRAPHICS_WRITE(Y2, y2);
+    GRAPHICS_WRITE(Colour, Colour);              // set pixel colour
+    GraphicsCommandReg = DrawFilledRect;         // give graphics "draw filled rectangle" command
+    PROFILE_COMMAND(DrawFilledRect, 6);
+    SHADOW_COMMAND(DrawFilledRect, x1, y1, x2, y2, Colour);
+}
+
+// Draw a rectangle with a top left coordinate of (x1,y1) that is width pixels wide and height pixels tall
+// The rectangle will be filled with the colour Colour, instead of being empty
+// The rectangle will have a border of width borderWidth and the border will have a colour of BorderColour
+void FilledRectangleWithBorder(int x1, int y1, int width, int height, int borderWidth, int FillColour, int BorderColour)
+{
+    // Draw Border
+    FilledRectangle(x1, y1, width, borderWidth, BorderColour); //Top
+    FilledRectangle(x1, y1+height-borderWidth, width, borderWidth, BorderColour); //Bottom
+    FilledRectangle(x1, y1, borderWidth, height, BorderColour); //Left
+    FilledRectangle(x1+width-borderWidth, y1, borderWidth, height, BorderColour); //Right
+
+    // Fill in
+    FilledRectangle(x1+borderWidth, y1+borderWidth, width-2*borderWidth, height-2*borderWidth, FillColour);
+}
+
+// Draws a circle centered at centreX and centreY
+void Circle(int centreX, int centreY, int radius, int Colour)
+{
+    int Clip = ClipCircle(centreX, centreY, radius);
+
+    if (Clip == CLIP_REJECT) {
+        return;
+    }
+    if (Clip == CLIP_PARTIAL) {
+        ClippedCircle(centreX, centreY, radius, Colour);
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawCircle, centreX, centreY, radius, 0, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, centreX);             // write coords to x1, y1
+    GRAPHICS_WRITE(Y1, centreY);
+    GRAPHICS_WRITE(X2, radius);              // write radius
+    GRAPHICS_WRITE(Colour, Colour);          // set pixel colour
+    GraphicsCommandReg = DrawCircle;         // give graphics "draw line" command
+    PROFILE_COMMAND(DrawCircle, 5);
+    SHADOW_COMMAND(DrawCircle, centreX, centreY, radius, 0, Colour);
+}
+
+// Queue one horizontal span of a filled circle, i.e. columns centreX-halfWidth to centreX+halfWidth of row y
+static void FilledCircleSpan(int centreX, int y, int halfWidth, int Colour)
+{
+    QueueSpan(centreX - halfWidth, centreX + halfWidth + 1, y, Colour);
+}
+
+// Draws a filled circle centered at centreX and centreY as one HLine per row
+// The rows come from the same midpoint algorithm the graphics chip uses for Circle (see the
+// DrawCircle states in GraphicsController_Verilog.v) so the filled circle covers exactly the
+// pixels inside and on the circle drawn by Circle
+void FilledCircle(int centreX, int centreY, int radius, int Colour)
+{
+    int offset_x = radius;
+    int offset_y = 0;
+    int crit = 1 - radius;
+
+    while (offset_y <= offset_x) {
+        // rows +/- offset_y are offset_x wide either side of the centre
+        FilledCircleSpan(centreX, centreY + offset_y, offset_x, Colour);
+        if (offset_y != 0) {
+            FilledCircleSpan(centreX, centreY - offset_y, offset_x, Colour);
+        }
+
+        offset_y++;
+        if (crit <= 0) {
+            crit += 2 * offset_y + 1;
+        } else {
+            // we are done with rows +/- offset_x, which are as wide as the last offset_y.
+            // Rows we have already drawn above (near 45 degrees) are not drawn again
+            if (offset_x > offset_y - 1) {
+                FilledCircleSpan(centreX, centreY + offset_x, offset_y - 1, Colour);
+                FilledCircleSpan(centreX, centreY - offset_x, offset_y - 1, Colour);
+            }
+            offset_x--;
+            crit += 2 * (offset_y - offset_x) + 1;
+        }
+    }
+}
+
+// Draws an ellipse centred at centreX and centreY that is radiusX pixels either side of the
+// centre across and radiusY pixels either side of it up and down
+void Ellipse(int centreX, int centreY, int radiusX, int radiusY, int Colour)
+{
+    int Clip = ClipEllipse(centreX, centreY, radiusX, radiusY);
+
+    if (Clip == CLIP_REJECT) {
+        return;
+    }
+    if (radiusY == 0) {             // the midpoint algorithm only gets as far as the centre
+        HLine(centreX - radiusX, centreY, 2 * radiusX + 1, Colour);
+        return;
+    }
+    if (Clip == CLIP_PARTIAL) {
+        ClippedEllipse(centreX, centreY, radiusX, radiusY, Colour);
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawEllipse, centreX, centreY, radiusX, radiusY, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, centreX);              // write coords to x1, y1
+    GRAPHICS_WRITE(Y1, centreY);
+    GRAPHICS_WRITE(X2, radiusX);              // write radii
+    GRAPHICS_WRITE(Y2, radiusY);
+    GRAPHICS_WRITE(Colour, Colour);           // set pixel colour
+    GraphicsCommandReg = DrawEllipse;         // give graphics "draw ellipse" command
+    PROFILE_COMMAND(DrawEllipse, 6);
+    SHADOW_COMMAND(DrawEllipse, centreX, centreY, radiusX, radiusY, Colour);
+}
+
+// Draws the parts of the circle centered at centreX and centreY that are in Octants, e.g.
+// ARC_TOP_LEFT | ARC_TOP_RIGHT for the top half. The pixels are the same ones Circle draws
+void Arc(int centreX, int centreY, int radius, int Octants, int Colour)
+{
+    int Clip = ClipCircle(centreX, centreY, radius);
+
+    Octants &= ARC_CIRCLE;
+    if (Clip == CLIP_REJECT || Octants == 0) {
+        return;
+    }
+    if (Clip == CLIP_PARTIAL) {
+        ClippedArc(centreX, centreY, radius, Octants, Colour);
+        return;
+    }
+    BACK_BUFFER_COMMAND(DrawArc, centreX, centreY, radius, Octants, Colour);
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, centreX);          // write coords to x1, y1
+    GRAPHICS_WRITE(Y1, centreY);
+    GRAPHICS_WRITE(X2, radius);           // write radius
+    GRAPHICS_WRITE(Y2, Octants);          // and the octants to draw
+    GRAPHICS_WRITE(Colour, Colour);       // set pixel colour
+    GraphicsCommandReg = DrawArc;         // give graphics "draw arc" command
+    PROFILE_COMMAND(DrawArc, 6);
+    SHADOW_COMMAND(DrawArc, centreX, centreY, radius, Octants, Colour);
+}
+
+// Draw a rectangle like Rectangle() but with its corners rounded off by quarter circles of radius
+// radius. The radius is made smaller if the rectangle is too small for it
+void RoundedRectangle(int x1, int y1, int width, int height, int radius, int Colour)
+{
+    int x2 = x1 + width - 1;            // right and bottom edges
+    int y2 = y1 + height - 1;
+
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (2 * radius >= width) {
+        radius = (width - 1) / 2;
+    }
+    if (2 * radius >= height) {
+        radius = (height - 1) / 2;
+    }
+    if (radius <= 0) {
+        Rectangle(x1, y1, width, height, Colour);
+        return;
+    }
+
+    // each arc ends on the rows and columns of the edges, so the straight parts start one pixel on
+    Arc(x1 + radius, y1 + radius, radius, ARC_TOP_LEFT, Colour);
+    Arc(x2 - radius, y1 + radius, radius, ARC_TOP_RIGHT, Colour);
+    Arc(x1 + radius, y2 - radius, radius, ARC_BOTTOM_LEFT, Colour);
+    Arc(x2 - radius, y2 - radius, radius, ARC_BOTTOM_RIGHT, Colour);
+
+    HLine(x1 + radius + 1, y1, width - 2 * radius - 2, Colour);
+    HLine(x1 + radius + 1, y2, width - 2 * radius - 2, Colour);
+    VLine(x1, y1 + radius + 1, height - 2 * radius - 2, Colour);
+    VLine(x2, y1 + radius + 1, height - 2 * radius - 2, Colour);
+}
+
+void FillScreen(int Colour)
+{
+    FilledRectangle(0,0,WIDTH,HEIGHT,Colour);
+}
@@ -0,0 +1,292 @@
+#ifndef GRAPHICS_H
+#define GRAPHICS_H
+
+// Size of screen
+#define WIDTH 800
+#define HEIGHT 480
+
+// the frame buffer sram (256k x 16 bits) holds 512 rows of 1024 pixels, of which WIDTH x HEIGHT are shown
+#define GRAPHICS_MEMORY_ROWS        512
+#define GRAPHICS_MEMORY_COLUMNS     1024
+
+// graphics register addresses
+//
+// When compiled for the host (gcc -DGRAPHICS_HOST_MODEL) the registers are replaced by the
+// software model of the graphics controller in GraphicsModel.c so the same driver code can be
+// run and timed without a DE1-SoC
+
+#ifdef GRAPHICS_HOST_MODEL
+
+#include "GraphicsModel.h"
+
+#else
+
+#define GraphicsCommandReg   		(*(volatile unsigned short int *)(0xFF210000))
+#define GraphicsStatusReg   		(*(volatile unsigned short int *)(0xFF210000))
+#define GraphicsX1Reg   			(*(volatile unsigned short int *)(0xFF210002))
+#define GraphicsY1Reg   			(*(volatile unsigned short int *)(0xFF210004))
+#define GraphicsX2Reg   			(*(volatile unsigned short int *)(0xFF210006))
+#define GraphicsY2Reg   			(*(volatile unsigned short int *)(0xFF210008))
+#define GraphicsColourReg   		(*(volatile unsigned short int *)(0xFF21000E))
+#define GraphicsColourLatchReg   	(*(volatile unsigned short int *)(0xFF21000E))	// reads of the colour reg return the last pixel read
+#define GraphicsBackGroundColourReg   	(*(volatile unsigned short int *)(0xFF210010))
+#define GraphicsPixelDataReg   		(*(volatile unsigned short int *)(0xFF21000A))	// pixels for a DrawBlit command
+#define GraphicsVSyncClearReg   		(*(volatile unsigned short int *)(0xFF21000C))	// any write clears GRAPHICS_STATUS_VSYNC_SEEN
+#define GraphicsDestXReg   			(*(volatile unsigned short int *)(0xFF210012))	// where a DrawCopyRect command copies to
+#define GraphicsDestYReg   			(*(volatile unsigned short int *)(0xFF210014))
+
+#endif
+
+// bits in the status register
+#define GRAPHICS_STATUS_IDLE            0x0001      // ready for a new command
+#define GRAPHICS_STATUS_PIXEL_DATA      0x0002      // the last pixel written to PixelData has not been drawn yet
+#define GRAPHICS_STATUS_VSYNC           0x0004      // the LCD is in vertical sync, part of vertical blanking
+#define GRAPHICS_STATUS_VSYNC_SEEN      0x0008      // a vertical sync has started since VSyncClear was written
+
+// the LCD refreshes at 30MHz / (993 x 503) pixel clocks, i.e. 60 frames a second
+#define GRAPHICS_REFRESH_HZ     60
+
+/************************************************************************************************
+** This macro pauses until the graphics chip status register indicates that it is idle
+** Anything still in the command queue (GraphicsQueue.c) is sent to the graphics chip first
+***********************************************************************************************/
+
+#define WAIT_FOR_GRAPHICS		{ GraphicsQueueFlush(); while((GraphicsStatusReg & 0x0001) != 0x0001) { PROFILE_WAIT; } }
+
+/************************************************************************************************
+** Profiling (GraphicsProfile.c), only compiled in when built with -DGRAPHICS_PROFILE.
+** PROFILE_COMMAND goes wherever a command is written to the command register, with the number of
+** register writes it took, and PROFILE_WAIT in every loop that waits for the graphics chip.
+** Otherwise they are nothing at all
+***********************************************************************************************/
+
+#ifdef GRAPHICS_PROFILE
+
+#define PROFILE_COMMAND(Command, Writes)    GraphicsProfileCommand(Command, Writes)
+#define PROFILE_WAIT                        (GraphicsProfile[GraphicsProfileLast].Waits++)
+
+#else
+
+#define PROFILE_COMMAND(Command, Writes)
+#define PROFILE_WAIT
+
+#endif
+
+/************************************************************************************************
+** Draw a command into the shadow frame buffer (GraphicsShadow.c), if it is turned on.
+** Used everywhere a drawing command is sent to or queued for the graphics chip
+***********************************************************************************************/
+
+#define SHADOW_COMMAND(Command, x1, y1, x2, y2, Colour) \
+    { if (GraphicsShadowEnabled) GraphicsShadowCommand(Command, x1, y1, x2, y2, Colour); }
+
+/************************************************************************************************
+** While a frame is being drawn off screen (GraphicsBackBuffer.c) draw a command into the back
+** buffer and return instead of sending it to the graphics chip. Used at the start of everything
+** that sends a drawing command to or queues one for the graphics chip
+***********************************************************************************************/
+
+#define BACK_BUFFER_COMMAND(Command, x1, y1, x2, y2, Colour) \
+    { if (GraphicsBackBufferActive) { GraphicsBackBufferCommand(Command, x1, y1, x2, y2, Colour); return; } }
+
+/************************************************************************************************
+** Write one of the graphics chip's coordinate or colour registers (X1, Y1, X2, Y2, Colour, DestX
+** or DestY), e.g. GRAPHICS_WRITE(X1, x). The graphics chip never changes them itself, so the
+** value last written is kept in GraphicsRegisters and a write of the same value again is left
+** out and counted in GraphicsElidedWrites. Call GraphicsForgetRegisters() if anything else could
+** have written them (e.g. after the graphics chip is reset) so they are all written next time
+***********************************************************************************************/
+
+#define GRAPHICS_WRITE(Register, Value) \
+    { int Value_ = (unsigned short int)(Value); \
+      if (GraphicsRegisters.Register == Value_) { GraphicsElidedWrites++; } \
+      else { GraphicsRegisters.Register = Value_; Graphics##Register##Reg = (unsigned short int)Value_; } }
+
+// entries in the graphics chip's colour palette (its palette ram has 6 address bits) and the
+// most ranges of it that can be colour cycled at once (GraphicsPalette.c)
+#define PALETTE_SIZE            64
+#define PALETTE_MAX_CYCLES      8
+
+// number of commands the command queue can hold before Queue functions have to wait
+#define GRAPHICS_QUEUE_SIZE     256
+
+// #defined constants representing values we write to the graphics 'command' register to get
+// it to draw something. You will add more values as you add hardware to the graphics chip
+
+#define DrawHLine		1
+#define DrawVLine		2
+#define DrawLine		3
+#define	PutAPixel		0xA
+#define	GetAPixel		0xB
+#define	ProgramPaletteColour    0x10
+#define DrawCircle      0x11
+#define DrawFilledRect  0x12
+#define DrawBlit        0x13
+#define DrawLineTo      0x14    // line from where the last Line or LineTo ended to X2,Y2
+#define DrawEllipse     0x15    // ellipse centred on X1,Y1 with X radius X2 and Y radius Y2
+#define DrawArc         0x16    // the octants of a circle in Y2, centred on X1,Y1 with radius X2
+#define DrawCopyRect    0x17    // copy X1,Y1 up to (not including) X2,Y2 to DestX,DestY, which may overlap
+
+// Octants of a circle for Arc(), going clockwise round the screen from 3 o'clock, and the
+// quarters of a circle made of them
+#define ARC_OCTANT_0        0x01
+#define ARC_OCTANT_1        0x02
+#define ARC_OCTANT_2        0x04
+#define ARC_OCTANT_3        0x08
+#define ARC_OCTANT_4        0x10
+#define ARC_OCTANT_5        0x20
+#define ARC_OCTANT_6        0x40
+#define ARC_OCTANT_7        0x80
+
+#define ARC_BOTTOM_RIGHT    (ARC_OCTANT_0 | ARC_OCTANT_1)
+#define ARC_BOTTOM_LEFT     (ARC_OCTANT_2 | ARC_OCTANT_3)
+#define ARC_TOP_LEFT        (ARC_OCTANT_4 | ARC_OCTANT_5)
+#define ARC_TOP_RIGHT       (ARC_OCTANT_6 | ARC_OCTANT_7)
+#define ARC_CIRCLE          0xFF
+
+// defined constants representing colours pre-programmed into colour palette
+// there are 256 colours but only 8 are shown below, we write these to the colour registers
+//
+// the header files "Colours.h" contains constants for all 256 colours
+// while the file "ColourPaletteData.c" contains the 24 bit RGB data
+// that is pre-programmed into the palette
+
+#define	BLACK			0
+#define	WHITE			1
+#define	RED			2
+#define	LIME			3
+#define	BLUE			4
+#define	YELLOW			5
+#define	CYAN			6
+#define	MAGENTA			7
+
+// Graphics.c
+typedef struct {
+    int X1, Y1, X2, Y2, Colour, DestX, DestY;   // -1 when not known
+} GraphicsRegisterValues;
+
+extern GraphicsRegisterValues GraphicsRegisters;
+extern unsigned long GraphicsElidedWrites;
+void GraphicsForgetRegisters(void);
+void WriteAPixel(int x, int y, int Colour);
+int ReadAPixel(int x, int y);
+int ReadAPixelFromGraphics(int x, int y);
+void ProgramPalette(int PaletteNumber, int RGB);
+void HLine(int x1, int y1, int length, int Colour);
+void VLine(int x1, int y1, int length, int Colour);
+void Line(int x1, int y1, int x2, int y2, int Colour);
+void Triangle(int x1, int y1, int x2, int y2, int x3, int y3, int Colour);
+void Rectangle(int x1, int y1, int width, int height, int Colour);
+void FilledRectangle(int x1, int y1, int width, int height, int Colour);
+void FilledRectangleWithBorder(int x1, int y1, int width, int height, int borderWidth, int FillColour, int BorderColour);
+void Circle(int centreX, int centreY, int radius, int Colour);
+void FilledCircle(int centreX, int centreY, int radius, int Colour);
+void Ellipse(int centreX, int centreY, int radiusX, int radiusY, int Colour);
+void Arc(int centreX, int centreY, int radius, int Octants, int Colour);
+void RoundedRectangle(int x1, int y1, int width, int height, int radius, int Colour);
+void FillScreen(int Colour);
+
+// GraphicsQueue.c
+int GraphicsQueueService(void);
+void GraphicsQueueFlush(void);
+int GraphicsQueueCount(void);
+unsigned int GraphicsQueueFence(void);
+int GraphicsFenceReached(unsigned int Fence);
+void GraphicsWait(unsigned int Fence);
+unsigned int QueueWritePixel(int x, int y, int Colour);
+unsigned int QueueReadPixel(int x, int y, int *Colour);
+unsigned int QueueProgramPalette(int PaletteNumber, int RGB);
+unsigned int QueueHLine(int x1, int y1, int length, int Colour);
+unsigned int QueueVLine(int x1, int y1, int length, int Colour);
+unsigned int QueueLine(int x1, int y1, int x2, int y2, int Colour);
+unsigned int QueueCircle(int centreX, int centreY, int radius, int Colour);
+unsigned int QueueFilledRectangle(int x1, int y1, int width, int height, int Colour);
+unsigned int QueueSpan(int x1, int x2, int y, int Colour);
+
+// GraphicsPolygon.c
+void FilledPolygon(const int *x, const int *y, int NumPoints, int Colour);
+void FilledTriangle(int x1, int y1, int x2, int y2, int x3, int y3, int Colour);
+void Polyline(const int *x, const int *y, int NumPoints, int Colour);
+void PolygonOutline(const int *x, const int *y, int NumPoints, int Colour);
+
+// GraphicsBlit.c
+void BlitRect(int x, int y, int width, int height, const unsigned char *pixels, int stride);
+void CopyRect(int srcX, int srcY, int width, int height, int dstX, int dstY);
+
+// GraphicsClip.c
+#define CLIP_ACCEPT     0       // all inside the clip rectangle, or the graphics chip can clip it
+#define CLIP_REJECT     1       // nothing inside the clip rectangle
+#define CLIP_PARTIAL    2       // has to be cut to the clip rectangle by the driver
+
+extern int ClipLeft, ClipTop, ClipRight, ClipBottom;
+void SetClipRectangle(int x1, int y1, int width, int height);
+void ResetClipRectangle(void);
+int ClipPixel(int x, int y);
+int ClipSpan(int *x1, int *x2, int y);
+int ClipVSpan(int x, int *y1, int *y2);
+int ClipBox(int *x1, int *y1, int *x2, int *y2);
+int ClipLine(int x1, int y1, int x2, int y2);
+void ClippedLine(int x1, int y1, int x2, int y2, int Colour);
+int ClipCircle(int centreX, int centreY, int radius);
+void ClippedCircle(int centreX, int centreY, int radius, int Colour);
+int ClipEllipse(int centreX, int centreY, int radiusX, int radiusY);
+void ClippedEllipse(int centreX, int centreY, int radiusX, int radiusY, int Colour);
+void ClippedArc(int centreX, int centreY, int radius, int Octants, int Colour);
+
+// GraphicsPalette.c
+int ReadPaletteColour(int PaletteNumber);
+void RememberPaletteColour(int PaletteNumber, int RGB);
+void ProgramPaletteRange(int First, int Count, const int *RGB);
+void ProgramWholePalette(const int *RGB);
+int AddPaletteCycle(int First, int Count, int Direction);
+void RemovePaletteCycle(int Cycle);
+void CyclePalettes(void);
+
+// GraphicsShadow.c
+extern int GraphicsShadowEnabled;
+extern unsigned char GraphicsShadow[GRAPHICS_MEMORY_ROWS][GRAPHICS_MEMORY_COLUMNS];
+extern unsigned long GraphicsShadowPixels;
+void GraphicsShadowEnable(void);
+void GraphicsShadowEnableFilled(int Colour);
+void GraphicsShadowDisable(void);
+void GraphicsShadowCommand(int Command, int x1, int y1, int x2, int y2, int Colour);
+int GraphicsShadowCheck(void);
+
+// GraphicsFill.c
+int FloodFill(int x, int y, int Colour);
+
+// GraphicsBackBuffer.c
+extern int GraphicsBackBufferActive;
+void GraphicsBeginFrame(void);
+void GraphicsFlip(void);
+void GraphicsDiscardFrame(void);
+void GraphicsBackBufferDamage(int y1, int y2);
+void GraphicsBackBufferCommand(int Command, int x1, int y1, int x2, int y2, int Colour);
+
+// GraphicsVSync.c
+int InVerticalSync(void);
+void WaitForVBlank(void);
+void SetFrameRate(int FramesPerSecond);
+void GraphicsEndFrame(void);
+
+// GraphicsProfile.c
+#define GRAPHICS_PROFILE_COMMANDS   32      // command numbers profiled, 0 up to this
+
+typedef struct {
+    unsigned long Commands;                 // commands sent to the graphics chip
+    unsigned long Writes;                   // register writes to send them
+    unsigned long Waits;                    // times round a loop waiting for the graphics chip to finish them
+    unsigned long long Ticks;               // timer ticks from sending one until the next command is sent
+} GraphicsProfileEntry;
+
+extern GraphicsProfileEntry GraphicsProfile[GRAPHICS_PROFILE_COMMANDS];
+extern int GraphicsProfileLast;
+void GraphicsProfileCommand(int Command, int Writes);
+void GraphicsProfileReset(void);
+void GraphicsProfilePrint(int (*PutChar)(int));
+
+// GraphicsRaster.c
+unsigned long RasterCommand(unsigned char (*FrameBuffer)[GRAPHICS_MEMORY_COLUMNS], int Command,
+    int x1, int y1, int x2, int y2, int Colour, unsigned long *PixelCount);
+
+#endif
@@ -0,0 +1,181 @@
+/************************************************************************************************
+** Drawing a whole frame off screen and then flipping it onto the screen
+**
+** The frame buffer has room for only one 800x480 page (its 512 rows x 1024 columns are addressed
+** directly by RamAddressMapper and the FPGA has no RAM blocks left for a second one), so the
+** back buffer is the shadow frame buffer (GraphicsShadow.c) in the HPS's DDR memory instead:
+**
+**  - between GraphicsBeginFrame() and GraphicsFlip() every drawing function draws into the back
+**    buffer only (see BACK_BUFFER_COMMAND in Graphics.h). Nothing on the screen changes and
+**    the graphics chip is never waited for, so the next frame can be worked out while the last
+**    one is still being shown
+**  - GraphicsFlip() compares the rows that were drawn on with a copy of what was on the screen
+**    when the frame was begun, and sends only the pixels in between the first and last one that
+**    changed in each row with BlitRect(). A frame that is mostly the same as the last one costs
+**    little more than the part that moved, however much of it was redrawn
+**
+** The flip is a copy, not a swap, so it is not instantaneous: start it in vertical blanking to
+** keep small changes from tearing, e.g. with GraphicsEndFrame() (GraphicsVSync.c)
+***********************************************************************************************/
+
+#include <string.h>
+
+#include "Graphics.h"
+
+int GraphicsBackBufferActive = 0;
+
+// what was on the screen when the frame was begun
+static unsigned char FrontBuffer[HEIGHT][WIDTH];
+
+// rows DirtyTop up to (not including) DirtyBottom have been drawn on since the frame was begun
+static int DirtyTop = HEIGHT;
+static int DirtyBottom = 0;
+
+/*********************************************************************************************
+** Start drawing a frame off screen. Turns the shadow frame buffer on first if it is not
+** already on, which reads the whole screen back from the graphics chip, so it is best done once
+** before the first frame
+*********************************************************************************************/
+
+void GraphicsBeginFrame(void)
+{
+    int y;
+
+    if (!GraphicsShadowEnabled) {
+        GraphicsShadowEnable();
+    }
+
+    for(y = 0; y < HEIGHT; y++) {
+        memcpy(FrontBuffer[y], GraphicsShadow[y], WIDTH);
+    }
+
+    DirtyTop = HEIGHT;
+    DirtyBottom = 0;
+    GraphicsBackBufferActive = 1;
+}
+
+// Note that rows y1 up to (not including) y2 of the back buffer have been drawn on
+void GraphicsBackBufferDamage(int y1, int y2)
+{
+    if (y1 < 0) {
+        y1 = 0;
+    }
+    if (y2 > HEIGHT) {
+        y2 = HEIGHT;
+    }
+    if (y1 >= y2) {
+        return;
+    }
+    if (y1 < DirtyTop) {
+        DirtyTop = y1;
+    }
+    if (y2 > DirtyBottom) {
+        DirtyBottom = y2;
+    }
+}
+
+// Draw a command into the back buffer instead of sending it to the graphics chip. Called
+// (through BACK_BUFFER_COMMAND) in place of everything that draws while a frame is begun
+void GraphicsBackBufferCommand(int Command, int x1, int y1, int x2, int y2, int Colour)
+{
+    GraphicsShadowCommand(Command, x1, y1, x2, y2, Colour);
+
+    if (Command == DrawCircle || Command == DrawArc) {      // x2 is the radius
+        GraphicsBackBufferDamage(y1 - x2, y1 + x2 + 1);
+    }
+    else if (Command == DrawEllipse) {      // y2 is the Y radius
+        GraphicsBackBufferDamage(y1 - y2, y1 + y2 + 1);
+    }
+    else if (Command == PutAPixel) {        // y2 is not used
+        GraphicsBackBufferDamage(y1, y1 + 1);
+    }
+    else if (Command == DrawHLine || Command == DrawVLine || Command == DrawLine || Command == DrawFilledRect) {
+        if (y1 <= y2) {
+            GraphicsBackBufferDamage(y1, y2 + 1);
+        }
+        else {
+            GraphicsBackBufferDamage(y2, y1 + 1);
+        }
+    }
+}
+
+// Columns *Left up to (not including) *Right of row y are everything that differs between
+// the back buffer and the screen. Returns 0 if nothing does
+static int ChangedColumns(int y, int *Left, int *Right)
+{
+    const unsigned char *Back = GraphicsShadow[y];
+    const unsigned char *Front = FrontBuffer[y];
+    int l = 0, r = WIDTH;
+
+    while (l < r && Back[l] == Front[l]) {
+        l++;
+    }
+    while (r > l && Back[r - 1] == Front[r - 1]) {
+        r--;
+    }
+
+    *Left = l;
+    *Right = r;
+    return l < r;
+}
+
+/*********************************************************************************************
+** Put the frame drawn since GraphicsBeginFrame() on the screen and go back to drawing on the
+** screen directly. Rows that changed by the same columns are sent with one BlitRect()
+*********************************************************************************************/
+
+void GraphicsFlip(void)
+{
+    int y, First = 0, Left, Right, RunLeft = 0, RunRight = 0, Running = 0;
+    int OldLeft = ClipLeft, OldTop = ClipTop, OldRight = ClipRight, OldBottom = ClipBottom;
+
+    if (!GraphicsBackBufferActive) {
+        return;
+    }
+    GraphicsBackBufferActive = 0;
+
+    // the back buffer was already clipped when it was drawn
+    ResetClipRectangle();
+
+    for(y = DirtyTop; y < DirtyBottom; y++) {
+        if (!ChangedColumns(y, &Left, &Right)) {
+            Left = Right = 0;
+        }
+        if (Running && (Left != RunLeft || Right != RunRight)) {
+            BlitRect(RunLeft, First, RunRight - RunLeft, y - First, &GraphicsShadow[First][RunLeft],
+                GRAPHICS_MEMORY_COLUMNS);
+            Running = 0;
+        }
+        if (!Running && Left < Right) {
+            First = y;
+            RunLeft = Left;
+            RunRight = Right;
+            Running = 1;
+        }
+    }
+    if (Running) {
+        BlitRect(RunLeft, First, RunRight - RunLeft, DirtyBottom - First, &GraphicsShadow[First][RunLeft],
+            GRAPHICS_MEMORY_COLUMNS);
+    }
+
+    ClipLeft = OldLeft;
+    ClipTop = OldTop;
+    ClipRight = OldRight;
+    ClipBottom = OldBottom;
+}
+
+// Throw away the frame drawn since GraphicsBeginFrame() and go back to drawing on the screen,
+// which has not changed
+void GraphicsDiscardFrame(void)
+{
+    int y;
+
+    if (!GraphicsBackBufferActive) {
+        return;
+    }
+    GraphicsBackBufferActive = 0;
+
+    for(y = DirtyTop; y < DirtyBottom; y++) {
+        memcpy(GraphicsShadow[y], FrontBuffer[y], WIDTH);
+    }
+}
@@ -0,0 +1,330 @@
+/************************************************************************************************
+** Graphics benchmarks
+**
+** Draws a fixed set of shapes for each kind of primitive and size class (short and long lines,
+** small and large circles, fills, screen clears, and lines and circles hanging off the edge of
+** the screen, which the driver clips) and prints how many shapes and pixels a second were drawn
+** as CSV, one line per benchmark. The shapes come from a fixed seed and our own
+** random number generator, so every run, on the board or the host, draws exactly the same thing
+** and the results can be compared from one version of the driver or Verilog to the next.
+**
+** Runs on the board (GraphicsBenchmark.amp) or on the host against the graphics controller model:
+**
+**      gcc -O2 -DGRAPHICS_HOST_MODEL -o GraphicsBenchmark GraphicsBenchmark.c Graphics.c \
+**          GraphicsQueue.c GraphicsPolygon.c GraphicsBlit.c GraphicsClip.c GraphicsPalette.c \
+**          GraphicsRaster.c GraphicsShadow.c GraphicsBackBuffer.c GraphicsVSync.c GraphicsModel.c \
+**          GraphicsProfile.c ColourPaletteData.c
+**
+** On the board time is measured with the Cortex-A9 private timer. On the host it is the number of
+** graphics controller clock cycles counted by the model, i.e. how long the graphics chip would
+** take to draw the same thing. The shapes are worked out before the timing starts, and the
+** pixels (frame buffer writes) each benchmark takes are counted by drawing it off screen first
+***********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graphics.h"
+
+#ifdef GRAPHICS_HOST_MODEL
+
+#define TICKS_PER_SECOND        GRAPHICS_MODEL_CLOCK_HZ
+
+static void StartTimer(void)
+{
+}
+
+static unsigned int ReadTimer(void)
+{
+    return (unsigned int)GraphicsModelStatistics.Clock;
+}
+
+#else
+
+// Cortex-A9 private timer, clocked at 200MHz. It counts down so we load it with the largest value
+#define MPCoreTimerLoad         (*(volatile unsigned int *)(0xFFFEC600))
+#define MPCoreTimerCounter      (*(volatile unsigned int *)(0xFFFEC604))
+#define MPCoreTimerControl      (*(volatile unsigned int *)(0xFFFEC608))
+
+#define TICKS_PER_SECOND        200000000
+
+static void StartTimer(void)
+{
+    MPCoreTimerControl = 0;                 // stop the timer
+    MPCoreTimerLoad = 0xFFFFFFFF;
+    MPCoreTimerControl = 3;                 // auto reload and enable
+}
+
+// ticks since StartTimer, wraps after about 21 seconds
+static unsigned int ReadTimer(void)
+{
+    return 0xFFFFFFFF - MPCoreTimerCounter;
+}
+
+#endif
+
+// the same shapes every run
+#define BENCHMARK_SEED          391
+
+// most shapes in one benchmark
+#define BENCHMARK_MAX_SHAPES    2000
+
+// kinds of shape
+#define SHAPE_HLINE             0
+#define SHAPE_VLINE             1
+#define SHAPE_LINE              2
+#define SHAPE_CIRCLE            3
+#define SHAPE_FILLED_RECT       4
+#define SHAPE_FILLED_CIRCLE     5
+#define SHAPE_FILLED_TRIANGLE   6
+#define SHAPE_CLEAR             7
+#define SHAPE_LINE_OFF_SCREEN   8
+#define SHAPE_CIRCLE_OFF_SCREEN 9
+
+typedef struct {
+    const char *Name;
+    int Shape;
+    int MinSize, MaxSize;       // length, radius, width/height or triangle box size, in pixels
+    int Count;                  // shapes drawn
+} Benchmark;
+
+static const Benchmark Benchmarks[] = {
+    { "hline short",            SHAPE_HLINE,             4,   16,  2000 },
+    { "hline long",             SHAPE_HLINE,             200, 799, 500 },
+    { "vline short",            SHAPE_VLINE,             4,   16,  2000 },
+    { "vline long",             SHAPE_VLINE,             200, 479, 500 },
+    { "line short",             SHAPE_LINE,              4,   16,  2000 },
+    { "line long",              SHAPE_LINE,              200, 470, 500 },
+    { "circle small",           SHAPE_CIRCLE,            2,   16,  2000 },
+    { "circle large",           SHAPE_CIRCLE,            100, 239, 200 },
+    { "filled rectangle small", SHAPE_FILLED_RECT,       4,   16,  2000 },
+    { "filled rectangle large", SHAPE_FILLED_RECT,       200, 479, 100 },
+    { "filled circle small",    SHAPE_FILLED_CIRCLE,     2,   16,  1000 },
+    { "filled circle large",    SHAPE_FILLED_CIRCLE,     100, 239, 50 },
+    { "filled triangle small",  SHAPE_FILLED_TRIANGLE,   16,  16,  2000 },
+    { "filled triangle medium", SHAPE_FILLED_TRIANGLE,   64,  64,  2000 },
+    { "filled triangle large",  SHAPE_FILLED_TRIANGLE,   400, 400, 200 },
+    { "clear screen",           SHAPE_CLEAR,             0,   0,   20 },
+    { "line off screen",        SHAPE_LINE_OFF_SCREEN,   200, 799, 500 },
+    { "circle off screen",      SHAPE_CIRCLE_OFF_SCREEN, 100, 799, 200 }
+};
+
+typedef struct {
+    short int x1, y1, x2, y2, x3, y3;
+    unsigned char Colour;
+} BenchmarkShape;
+
+static BenchmarkShape Shapes[BENCHMARK_MAX_SHAPES];
+
+static unsigned int RandomState;
+
+// xorshift random numbers, so the shapes do not depend on which C library's rand() we have
+static unsigned int Random(void)
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return RandomState;
+}
+
+// pick a number from Min to Max-1
+static int RandomRange(int Min, int Max)
+{
+    return Min + (int)(Random() % (unsigned int)(Max - Min));
+}
+
+// a line of length (the number of pixels drawn) Length in any direction, all on the screen or,
+// if not OnScreen, starting anywhere on it and going wherever it goes
+static void MakeLine(BenchmarkShape *Shape, int Length, int OnScreen)
+{
+    int dx, dy, Along = RandomRange(-Length, Length + 1);
+
+    if (Random() & 1) {
+        dx = (Random() & 1) ? Length : -Length;
+        dy = Along;
+    } else {
+        dx = Along;
+        dy = (Random() & 1) ? Length : -Length;
+    }
+
+    if (OnScreen) {
+        Shape->x1 = RandomRange((dx < 0) ? -dx : 0, (dx > 0) ? WIDTH - dx : WIDTH);
+        Shape->y1 = RandomRange((dy < 0) ? -dy : 0, (dy > 0) ? HEIGHT - dy : HEIGHT);
+    } else {
+        Shape->x1 = RandomRange(0, WIDTH);
+        Shape->y1 = RandomRange(0, HEIGHT);
+    }
+    Shape->x2 = Shape->x1 + dx;
+    Shape->y2 = Shape->y1 + dy;
+}
+
+// Work out the shapes for a benchmark, all on the screen (apart from the off screen ones) and
+// none of them black
+static void MakeShapes(const Benchmark *Test)
+{
+    BenchmarkShape *Shape;
+    int i, Size, x, y;
+
+    RandomState = BENCHMARK_SEED;
+
+    for(i = 0, Shape = Shapes; i < Test->Count; i++, Shape++) {
+        Size = RandomRange(Test->MinSize, Test->MaxSize + 1);
+        Shape->Colour = RandomRange(1, 8);
+
+        switch (Test->Shape) {
+            case SHAPE_HLINE:
+                Shape->x1 = RandomRange(0, WIDTH - Size + 1);
+                Shape->y1 = RandomRange(0, HEIGHT);
+                Shape->x2 = Size;
+                break;
+
+            case SHAPE_VLINE:
+                Shape->x1 = RandomRange(0, WIDTH);
+                Shape->y1 = RandomRange(0, HEIGHT - Size + 1);
+                Shape->x2 = Size;
+                break;
+
+            case SHAPE_LINE:
+                MakeLine(Shape, Size, 1);
+                break;
+
+            case SHAPE_LINE_OFF_SCREEN:
+                MakeLine(Shape, Size, 0);
+                break;
+
+            case SHAPE_CIRCLE:
+            case SHAPE_FILLED_CIRCLE:
+                Shape->x1 = RandomRange(Size, WIDTH - Size);
+                Shape->y1 = RandomRange(Size, HEIGHT - Size);
+                Shape->x2 = Size;
+                break;
+
+            // centred anywhere on the screen, so most are partly off it
+            case SHAPE_CIRCLE_OFF_SCREEN:
+                Shape->x1 = RandomRange(0, WIDTH);
+                Shape->y1 = RandomRange(0, HEIGHT);
+                Shape->x2 = Size;
+                break;
+
+            case SHAPE_FILLED_RECT:
+                Shape->x2 = Size;
+                Shape->y2 = RandomRange(Test->MinSize, Test->MaxSize + 1);
+                Shape->x1 = RandomRange(0, WIDTH - Shape->x2 + 1);
+                Shape->y1 = RandomRange(0, HEIGHT - Shape->y2 + 1);
+                break;
+
+            case SHAPE_FILLED_TRIANGLE:
+                x = RandomRange(0, WIDTH - Size);
+                y = RandomRange(0, HEIGHT - Size);
+                Shape->x1 = x + RandomRange(0, Size);
+                Shape->y1 = y + RandomRange(0, Size);
+                Shape->x2 = x + RandomRange(0, Size);
+                Shape->y2 = y + RandomRange(0, Size);
+                Shape->x3 = x + RandomRange(0, Size);
+                Shape->y3 = y + RandomRange(0, Size);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+// Draw the shapes for a benchmark, with the queued versions of the shapes where there are any
+static void DrawShapes(const Benchmark *Test)
+{
+    const BenchmarkShape *Shape;
+    int i;
+
+    for(i = 0, Shape = Shapes; i < Test->Count; i++, Shape++) {
+        switch (Test->Shape) {
+            case SHAPE_HLINE:
+                QueueHLine(Shape->x1, Shape->y1, Shape->x2, Shape->Colour);
+                break;
+
+            case SHAPE_VLINE:
+                QueueVLine(Shape->x1, Shape->y1, Shape->x2, Shape->Colour);
+                break;
+
+            case SHAPE_LINE:
+            case SHAPE_LINE_OFF_SCREEN:
+                QueueLine(Shape->x1, Shape->y1, Shape->x2, Shape->y2, Shape->Colour);
+                break;
+
+            case SHAPE_CIRCLE:
+            case SHAPE_CIRCLE_OFF_SCREEN:
+                QueueCircle(Shape->x1, Shape->y1, Shape->x2, Shape->Colour);
+                break;
+
+            case SHAPE_FILLED_RECT:
+                QueueFilledRectangle(Shape->x1, Shape->y1, Shape->x2, Shape->y2, Shape->Colour);
+                break;
+
+            case SHAPE_FILLED_CIRCLE:
+                FilledCircle(Shape->x1, Shape->y1, Shape->x2, Shape->Colour);
+                break;
+
+            case SHAPE_FILLED_TRIANGLE:
+                FilledTriangle(Shape->x1, Shape->y1, Shape->x2, Shape->y2, Shape->x3, Shape->y3, Shape->Colour);
+                break;
+
+            case SHAPE_CLEAR:
+                FillScreen(Shape->Colour);
+                break;
+        }
+    }
+}
+
+/*********************************************************************************************
+** Run one benchmark on a black screen and print its CSV line. Its pixels are counted first by
+** drawing it into the back buffer (GraphicsBackBuffer.c), which is then thrown away. The time
+** includes the graphics chip finishing the last shape
+*********************************************************************************************/
+
+static void RunBenchmark(const Benchmark *Test)
+{
+    unsigned long Pixels;
+    unsigned int Start, Ticks;
+
+    MakeShapes(Test);
+
+    // the screen is known to be black, so the shadow frame buffer the back buffer needs is
+    // turned on without reading the screen back, and off again for the timed run
+    FillScreen(BLACK);
+    GraphicsShadowEnableFilled(BLACK);
+    GraphicsBeginFrame();
+    GraphicsShadowPixels = 0;
+    DrawShapes(Test);
+    Pixels = GraphicsShadowPixels;
+    GraphicsDiscardFrame();
+    GraphicsShadowDisable();
+    WAIT_FOR_GRAPHICS;
+
+    StartTimer();
+    Start = ReadTimer();
+
+    DrawShapes(Test);
+    WAIT_FOR_GRAPHICS;
+
+    Ticks = ReadTimer() - Start;
+    if (Ticks == 0) {
+        Ticks = 1;
+    }
+
+    printf("%s,%d,%d,%d,%lu,%u,%.1f,%.1f\n", Test->Name, Test->MinSize, Test->MaxSize, Test->Count,
+        Pixels, Ticks, (double)Test->Count * TICKS_PER_SECOND / Ticks,
+        (double)Pixels * TICKS_PER_SECOND / Ticks);
+}
+
+int main(void)
+{
+    int i;
+
+    printf("benchmark,min size,max size,shapes,pixels,ticks,shapes/sec,pixels/sec\n");
+
+    for(i = 0; i < (int)(sizeof(Benchmarks) / sizeof(Benchmarks[0])); i++) {
+        RunBenchmark(&Benchmarks[i]);
+    }
+
+    return 0;
+}
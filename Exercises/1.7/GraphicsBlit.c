@@ -0,0 +1,241 @@
+/************************************************************************************************
+** Copying a rectangle of pixels (e.g. an image) from memory to the screen
+**
+** There are two ways of getting the pixels to the graphics chip:
+**
+**  1) a DrawBlit command, after which the CPU writes each pixel in turn to the PixelData register.
+**     The graphics chip moves on to the next pixel by itself, so it costs one register write per pixel
+**
+**  2) one HLine per run of pixels of the same colour. Each costs about BLIT_WRITES_PER_RUN
+**     register accesses however long the run is, so it is cheaper for rows with few, long runs
+**     (e.g. icons or text on a plain background)
+**
+** BlitRect() counts the runs in each row and picks whichever means fewer register accesses.
+** Rows that are streamed one after the other are sent as a single DrawBlit command.
+**
+** CopyRect() copies a rectangle that is already on the screen somewhere else on it with one
+** DrawCopyRect command, so scrolling is one command plus drawing whatever scrolls into view
+***********************************************************************************************/
+
+#include <string.h>
+
+#include "Graphics.h"
+
+// register accesses to draw one run with an HLine: X1, Y1, X2, Y2, Colour, Command and a status read
+#define BLIT_WRITES_PER_RUN     7
+
+// number of runs of the same colour in the first width pixels of row, stopping once there are
+// more than Limit of them
+static int CountRuns(const unsigned char *row, int width, int Limit)
+{
+    int i, Runs = 1;
+
+    for(i = 1; i < width && Runs <= Limit; i++) {
+        if (row[i] != row[i - 1]) {
+            Runs++;
+        }
+    }
+    return Runs;
+}
+
+// draw one row as an HLine per run of the same colour
+static void BlitRowAsRuns(int x, int y, int width, const unsigned char *row)
+{
+    int Start = 0, i;
+
+    for(i = 1; i <= width; i++) {
+        if (i == width || row[i] != row[Start]) {
+            QueueHLine(x + Start, y, i - Start, row[Start]);
+            Start = i;
+        }
+    }
+}
+
+// stream "height" rows of pixels starting at x,y to the graphics chip with one DrawBlit command
+static void BlitRowsAsPixels(int x, int y, int width, int height, const unsigned char *pixels, int stride)
+{
+    const unsigned char *row;
+    int i, j;
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, x);          // write coords to x1, y1, and x2, y2
+    GRAPHICS_WRITE(Y1, y);
+    GRAPHICS_WRITE(X2, x + width);  // We don't write to column x2 or row y2, they are stopping points
+    GRAPHICS_WRITE(Y2, y + height);
+    GraphicsCommandReg = DrawBlit;  // give graphics "blit" command, then it waits for the pixels
+    PROFILE_COMMAND(DrawBlit, 5 + width * height);
+
+    // PixelData holds only one pixel, so the first one has to be drawn before the next is
+    // written: until then the graphics chip may still be on its way from Idle to DrawBlit.
+    // Once in DrawBlit it draws each pixel on the first clock after the CPU's write has finished
+    // (AS_L high), which is always before the next write can start, so the rest need no check
+    GraphicsPixelDataReg = pixels[0];
+    while ((GraphicsStatusReg & GRAPHICS_STATUS_PIXEL_DATA) != 0) {
+        PROFILE_WAIT;
+    }
+    for(j = 0, row = pixels; j < height; j++, row += stride) {
+        for(i = (j == 0) ? 1 : 0; i < width; i++) {
+            GraphicsPixelDataReg = row[i];
+        }
+    }
+
+    if (GraphicsShadowEnabled) {
+        for(j = 0, row = pixels; j < height; j++, row += stride) {
+            for(i = 0; i < width; i++) {
+                GraphicsShadow[y + j][x + i] = row[i];
+            }
+        }
+    }
+}
+
+/*********************************************************************************************
+** Copy a width x height rectangle of palette numbers to the screen with its top left corner at
+** x,y. Pixel (i,j) of the rectangle is pixels[j * stride + i]. Anything outside the clip
+** rectangle is cut off
+*********************************************************************************************/
+
+void BlitRect(int x, int y, int width, int height, const unsigned char *pixels, int stride)
+{
+    int j, First = 0, Streaming = 0;
+    const unsigned char *row;
+
+    // cut the rectangle to the clip rectangle (GraphicsClip.c)
+    if (x < ClipLeft) {
+        pixels += ClipLeft - x;
+        width -= ClipLeft - x;
+        x = ClipLeft;
+    }
+    if (y < ClipTop) {
+        pixels += (ClipTop - y) * stride;
+        height -= ClipTop - y;
+        y = ClipTop;
+    }
+    if (x + width > ClipRight) {
+        width = ClipRight - x;
+    }
+    if (y + height > ClipBottom) {
+        height = ClipBottom - y;
+    }
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // while a frame is being drawn off screen (GraphicsBackBuffer.c) the pixels only go into the back buffer
+    if (GraphicsBackBufferActive) {
+        for(j = 0, row = pixels; j < height; j++, row += stride) {
+            memcpy(&GraphicsShadow[y + j][x], row, width);
+        }
+        GraphicsBackBufferDamage(y, y + height);
+        return;
+    }
+
+    for(j = 0, row = pixels; j < height; j++, row += stride) {
+        if (CountRuns(row, width, width / BLIT_WRITES_PER_RUN) * BLIT_WRITES_PER_RUN < width) {
+            if (Streaming) {
+                BlitRowsAsPixels(x, y + First, width, j - First, pixels + First * stride, stride);
+                Streaming = 0;
+            }
+            BlitRowAsRuns(x, y + j, width, row);
+        }
+        else if (!Streaming) {
+            First = j;
+            Streaming = 1;
+        }
+    }
+
+    if (Streaming) {
+        BlitRowsAsPixels(x, y + First, width, height - First, pixels + First * stride, stride);
+    }
+}
+
+// Copy the same rectangle in the shadow frame buffer, a row at a time in whichever order reads
+// each row before it is overwritten (memmove looks after rows that overlap themselves)
+static void CopyShadowRect(int srcX, int srcY, int width, int height, int dstX, int dstY)
+{
+    int j;
+
+    if (dstY > srcY) {
+        for(j = height - 1; j >= 0; j--) {
+            memmove(&GraphicsShadow[dstY + j][dstX], &GraphicsShadow[srcY + j][srcX], width);
+        }
+    }
+    else {
+        for(j = 0; j < height; j++) {
+            memmove(&GraphicsShadow[dstY + j][dstX], &GraphicsShadow[srcY + j][srcX], width);
+        }
+    }
+}
+
+/*********************************************************************************************
+** Copy the width x height rectangle of the screen with its top left corner at srcX,srcY so its
+** top left corner is at dstX,dstY. The two may overlap, e.g. scrolling up one 10 pixel row is
+**
+**      CopyRect(0, 10, WIDTH, HEIGHT - 10, 0, 0);
+**
+** Only the part that lands inside the clip rectangle and comes from on the screen is copied.
+** The graphics chip takes 3 of its clocks a pixel, about 23ms for the whole screen
+*********************************************************************************************/
+
+void CopyRect(int srcX, int srcY, int width, int height, int dstX, int dstY)
+{
+    // cut the destination to the clip rectangle (GraphicsClip.c) and the source to the screen,
+    // moving the other one with it
+    if (dstX < ClipLeft) {
+        width -= ClipLeft - dstX;
+        srcX += ClipLeft - dstX;
+        dstX = ClipLeft;
+    }
+    if (dstY < ClipTop) {
+        height -= ClipTop - dstY;
+        srcY += ClipTop - dstY;
+        dstY = ClipTop;
+    }
+    if (srcX < 0) {
+        width += srcX;
+        dstX -= srcX;
+        srcX = 0;
+    }
+    if (srcY < 0) {
+        height += srcY;
+        dstY -= srcY;
+        srcY = 0;
+    }
+    if (dstX + width > ClipRight) {
+        width = ClipRight - dstX;
+    }
+    if (dstY + height > ClipBottom) {
+        height = ClipBottom - dstY;
+    }
+    if (srcX + width > WIDTH) {
+        width = WIDTH - srcX;
+    }
+    if (srcY + height > HEIGHT) {
+        height = HEIGHT - srcY;
+    }
+    if (width <= 0 || height <= 0 || (srcX == dstX && srcY == dstY)) {
+        return;
+    }
+
+    // while a frame is being drawn off screen (GraphicsBackBuffer.c) only the back buffer is copied
+    if (GraphicsBackBufferActive) {
+        CopyShadowRect(srcX, srcY, width, height, dstX, dstY);
+        GraphicsBackBufferDamage(dstY, dstY + height);
+        return;
+    }
+
+    WAIT_FOR_GRAPHICS;              // is graphics ready for new command
+
+    GRAPHICS_WRITE(X1, srcX);               // write coords of the rectangle to copy to x1, y1, and x2, y2
+    GRAPHICS_WRITE(Y1, srcY);
+    GRAPHICS_WRITE(X2, srcX + width);       // We don't copy column x2 or row y2, they are stopping points
+    GRAPHICS_WRITE(Y2, srcY + height);
+    GRAPHICS_WRITE(DestX, dstX);            // and where to copy it to
+    GRAPHICS_WRITE(DestY, dstY);
+    GraphicsCommandReg = DrawCopyRect;      // give graphics "copy rectangle" command
+    PROFILE_COMMAND(DrawCopyRect, 7);
+
+    if (GraphicsShadowEnabled) {
+        CopyShadowRect(srcX, srcY, width, height, dstX, dstY);
+    }
+}
@@ -0,0 +1,153 @@
+/************************************************************************************************
+** Sending what is on the screen to a host computer over the RS232 port
+**
+** GraphicsCaptureSend() takes the screen from the shadow frame buffer (GraphicsShadow.c), turning
+** it on if it is off, so only the first capture reads the screen back from the graphics chip. It
+** compresses each row and sends it in the chunks described in GraphicsCapture.h. Delta frames
+** only send the pixels that have changed since the last frame we sent, so the copy of that frame
+** is kept here. Call Init_RS232() first.
+** On the host, GraphicsCaptureDecode turns what is received back into image files
+***********************************************************************************************/
+
+#include <string.h>
+
+#include "Graphics.h"
+#include "GraphicsCapture.h"
+#include "RS232.h"
+
+// the last frame sent, for delta frames
+static unsigned char CapturePrevious[HEIGHT][WIDTH];
+static int CaptureHavePrevious = 0;
+static unsigned int CaptureFrameNumber = 0;
+
+// the row being captured and the codes it is compressed into (at worst one code per
+// CAPTURE_MAX_LITERAL pixels on top of the pixels themselves)
+static unsigned char CaptureRow[WIDTH];
+static unsigned char CaptureCodes[2 + WIDTH + WIDTH / CAPTURE_MAX_LITERAL + 1];
+
+// send a chunk of Length bytes, working out its checksum as we go
+static void CaptureSendChunk(int Type, const unsigned char *Data, int Length)
+{
+    int i, Checksum;
+
+    putcharRS232(CAPTURE_SYNC);
+    putcharRS232(Type);
+    putcharRS232(Length & 0xFF);
+    putcharRS232((Length >> 8) & 0xFF);
+    Checksum = Type + (Length & 0xFF) + ((Length >> 8) & 0xFF);
+
+    for(i = 0; i < Length; i++) {
+        putcharRS232(Data[i]);
+        Checksum += Data[i];
+    }
+    putcharRS232(Checksum & 0xFF);
+}
+
+// number of pixels from Start (up to Max) that have not changed since the last frame
+static int CaptureSkipLength(const unsigned char *Previous, int Start, int Max)
+{
+    int i = Start;
+
+    if (Previous == 0) {
+        return 0;
+    }
+    while (i < WIDTH && i - Start < Max && CaptureRow[i] == Previous[i]) {
+        i++;
+    }
+    return i - Start;
+}
+
+// number of pixels from Start (up to Max) that are the same palette number
+static int CaptureRepeatLength(int Start, int Max)
+{
+    int i = Start + 1;
+
+    while (i < WIDTH && i - Start < Max && CaptureRow[i] == CaptureRow[Start]) {
+        i++;
+    }
+    return i - Start;
+}
+
+/*********************************************************************************************
+** Compress CaptureRow into CaptureCodes after the row number, comparing it with Previous
+** (the same row of the last frame) or with nothing if Previous is 0.
+** Returns the number of bytes in CaptureCodes
+*********************************************************************************************/
+
+static int CaptureEncodeRow(const unsigned char *Previous)
+{
+    int Length = 2, x = 0, Run, Literal;
+
+    while (x < WIDTH) {
+        if ((Run = CaptureSkipLength(Previous, x, CAPTURE_MAX_SKIP)) > 0) {
+            CaptureCodes[Length++] = CAPTURE_SKIP + Run - 1;
+            x += Run;
+        }
+        else if ((Run = CaptureRepeatLength(x, CAPTURE_MAX_REPEAT)) >= 3) {
+            CaptureCodes[Length++] = CAPTURE_REPEAT + Run - 1;
+            CaptureCodes[Length++] = CaptureRow[x];
+            x += Run;
+        }
+        else {
+            // palette numbers one at a time until something cheaper comes along
+            Literal = Length++;
+            Run = 0;
+            do {
+                CaptureCodes[Length++] = CaptureRow[x++];
+                Run++;
+            } while (x < WIDTH && Run < CAPTURE_MAX_LITERAL &&
+                     CaptureSkipLength(Previous, x, 2) < 2 && CaptureRepeatLength(x, 3) < 3);
+            CaptureCodes[Literal] = CAPTURE_LITERAL + Run - 1;
+        }
+    }
+    return Length;
+}
+
+/*********************************************************************************************
+** Capture the screen and send it over the RS232 port. If Delta is non zero only what has
+** changed since the last capture is sent (the first capture is always a key frame)
+*********************************************************************************************/
+
+void GraphicsCaptureSend(int Delta)
+{
+    unsigned char Header[7];
+    int y, Changed;
+
+    if (!GraphicsShadowEnabled) {
+        GraphicsShadowEnable();
+    }
+    Delta = Delta && CaptureHavePrevious;
+
+    Header[0] = CaptureFrameNumber & 0xFF;
+    Header[1] = (CaptureFrameNumber >> 8) & 0xFF;
+    Header[2] = WIDTH & 0xFF;
+    Header[3] = (WIDTH >> 8) & 0xFF;
+    Header[4] = HEIGHT & 0xFF;
+    Header[5] = (HEIGHT >> 8) & 0xFF;
+    Header[6] = Delta ? CAPTURE_DELTA : 0;
+    CaptureSendChunk(CAPTURE_FRAME, Header, 7);
+
+    for(y = 0; y < HEIGHT; y++) {
+        memcpy(CaptureRow, GraphicsShadow[y], WIDTH);
+        Changed = !Delta || memcmp(CaptureRow, CapturePrevious[y], WIDTH) != 0;
+
+        if (Changed) {
+            CaptureCodes[0] = y & 0xFF;
+            CaptureCodes[1] = (y >> 8) & 0xFF;
+            CaptureSendChunk(CAPTURE_ROW, CaptureCodes, CaptureEncodeRow(Delta ? CapturePrevious[y] : 0));
+
+            memcpy(CapturePrevious[y], CaptureRow, WIDTH);
+        }
+    }
+
+    CaptureSendChunk(CAPTURE_END, Header, 2);
+
+    CaptureHavePrevious = 1;
+    CaptureFrameNumber++;
+}
+
+// forget the last frame, so the next capture is a key frame (e.g. if the host has restarted)
+void GraphicsCaptureReset(void)
+{
+    CaptureHavePrevious = 0;
+}
@@ -0,0 +1,47 @@
+#ifndef GRAPHICS_CAPTURE_H
+#define GRAPHICS_CAPTURE_H
+
+/************************************************************************************************
+** Format of screen captures sent over the RS232 port by GraphicsCapture.c and read back on the
+** host by GraphicsCaptureDecode.c
+**
+** Everything is sent as chunks:
+**
+**      CAPTURE_SYNC, Type, Length (2 bytes, low byte first), Length bytes of data, Checksum
+**
+** where Checksum is the low 8 bits of the sum of Type, the two length bytes and the data, so the
+** decoder can throw away anything damaged on the way and find the start of the next chunk.
+** A frame is a CAPTURE_FRAME chunk, a CAPTURE_ROW chunk for every row that is sent and a
+** CAPTURE_END chunk. Each row is the row number (2 bytes) followed by codes:
+**
+**      0x00 - 0x7F     the next byte is a palette number repeated (code + 1) times
+**      0x80 - 0xBF     (code - 0x80 + 1) pixels have not changed since the last frame
+**      0xC0 - 0xFF     (code - 0xC0 + 1) palette numbers follow, one per pixel
+**
+** Unchanged pixels are only used in delta frames, and rows that have not changed at all are not
+** sent, so after the first (key) frame only what has been drawn since goes over the serial port
+***********************************************************************************************/
+
+#define CAPTURE_SYNC            0xA5
+
+// chunk types
+#define CAPTURE_FRAME           'F'     // frame number (2 bytes), width (2), height (2), flags (1)
+#define CAPTURE_ROW             'R'     // row number (2 bytes) and codes as above
+#define CAPTURE_END             'E'     // frame number (2 bytes)
+
+// CAPTURE_FRAME flags
+#define CAPTURE_DELTA           0x01    // rows not sent (and unchanged pixels) are as in the last frame
+
+// codes in a row
+#define CAPTURE_REPEAT          0x00
+#define CAPTURE_SKIP            0x80
+#define CAPTURE_LITERAL         0xC0
+#define CAPTURE_MAX_REPEAT      128
+#define CAPTURE_MAX_SKIP        64
+#define CAPTURE_MAX_LITERAL     64
+
+// GraphicsCapture.c
+void GraphicsCaptureSend(int Delta);
+void GraphicsCaptureReset(void);
+
+#endif
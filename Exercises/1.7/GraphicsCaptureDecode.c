@@ -0,0 +1,198 @@
+/************************************************************************************************
+** Host (Linux) program that turns screen captures sent by GraphicsCapture.c back into images
+**
+**      gcc -O2 -o GraphicsCaptureDecode GraphicsCaptureDecode.c ColourPaletteData.c
+**      GraphicsCaptureDecode /dev/ttyUSB0 [prefix]
+**
+** Reads chunks (see GraphicsCapture.h) from a file or serial port that has been set up with
+** stty and writes each complete frame to prefix_NNNN.ppm (capture_NNNN.ppm by default).
+** Damaged chunks are counted and skipped, and a damaged row in a delta frame stays as it was
+** until the next key frame
+***********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "GraphicsCapture.h"
+
+// the palette ram only has 6 address bits so only 64 of the 256 palette numbers are distinct
+#define DECODE_PALETTE_SIZE     64
+
+// largest screen we will decode
+#define DECODE_MAX_WIDTH        1024
+#define DECODE_MAX_HEIGHT       512
+
+extern const int ColourPaletteData[256];
+
+static unsigned char Image[DECODE_MAX_HEIGHT][DECODE_MAX_WIDTH];
+static int ImageWidth = 0, ImageHeight = 0;
+static int HaveKeyFrame = 0;
+static unsigned long BadChunks = 0;
+
+static unsigned char Chunk[65536];
+
+/*********************************************************************************************
+** Read the next chunk from fp into Chunk. Returns its type, or EOF at the end of the input.
+** Anything before a sync byte and any chunk with a bad checksum is thrown away
+*********************************************************************************************/
+
+static int ReadChunk(FILE *fp, int *Length)
+{
+    int c, Type, i, Checksum;
+
+    for(;;) {
+        while ((c = fgetc(fp)) != CAPTURE_SYNC) {
+            if (c == EOF) {
+                return EOF;
+            }
+        }
+
+        if ((Type = fgetc(fp)) == EOF || (c = fgetc(fp)) == EOF) {
+            return EOF;
+        }
+        *Length = c;
+        if ((c = fgetc(fp)) == EOF) {
+            return EOF;
+        }
+        *Length |= c << 8;
+        Checksum = Type + (*Length & 0xFF) + (*Length >> 8);
+
+        for(i = 0; i < *Length; i++) {
+            if ((c = fgetc(fp)) == EOF) {
+                return EOF;
+            }
+            Chunk[i] = (unsigned char)c;
+            Checksum += c;
+        }
+
+        if ((c = fgetc(fp)) == EOF) {
+            return EOF;
+        }
+        if (c == (Checksum & 0xFF)) {
+            return Type;
+        }
+        BadChunks++;
+    }
+}
+
+// decode the codes of a row chunk into the image. Returns 0 if they do not make sense
+static int DecodeRow(const unsigned char *Data, int Length, int Delta)
+{
+    int y = Data[0] | (Data[1] << 8);
+    int x = 0, i = 2, Code, Count;
+
+    if (y >= ImageHeight) {
+        return 0;
+    }
+
+    while (i < Length) {
+        Code = Data[i++];
+        if (Code < CAPTURE_SKIP) {
+            Count = Code - CAPTURE_REPEAT + 1;
+            if (i >= Length || x + Count > ImageWidth) {
+                return 0;
+            }
+            memset(&Image[y][x], Data[i++], Count);
+        }
+        else if (Code < CAPTURE_LITERAL) {
+            Count = Code - CAPTURE_SKIP + 1;
+            if (!Delta || x + Count > ImageWidth) {
+                return 0;
+            }
+        }
+        else {
+            Count = Code - CAPTURE_LITERAL + 1;
+            if (i + Count > Length || x + Count > ImageWidth) {
+                return 0;
+            }
+            memcpy(&Image[y][x], &Data[i], Count);
+            i += Count;
+        }
+        x += Count;
+    }
+    return x == ImageWidth;
+}
+
+static int SavePPM(const char *FileName)
+{
+    FILE *fp;
+    int x, y, RGB;
+
+    fp = fopen(FileName, "wb");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    fprintf(fp, "P6\n%d %d\n255\n", ImageWidth, ImageHeight);
+    for(y = 0; y < ImageHeight; y++) {
+        for(x = 0; x < ImageWidth; x++) {
+            RGB = ColourPaletteData[Image[y][x] & (DECODE_PALETTE_SIZE - 1)];
+            fputc((RGB >> 16) & 0xFF, fp);
+            fputc((RGB >> 8) & 0xFF, fp);
+            fputc(RGB & 0xFF, fp);
+        }
+    }
+
+    fclose(fp);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *fp;
+    const char *Prefix = "capture";
+    char FileName[256];
+    int Type, Length, Delta = 0, Frame = 0, Frames = 0, Width, Height;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s capture-file-or-serial-port [prefix]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        Prefix = argv[2];
+    }
+
+    fp = fopen(argv[1], "rb");
+    if (fp == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    while ((Type = ReadChunk(fp, &Length)) != EOF) {
+        if (Type == CAPTURE_FRAME && Length == 7) {
+            Frame = Chunk[0] | (Chunk[1] << 8);
+            Width = Chunk[2] | (Chunk[3] << 8);
+            Height = Chunk[4] | (Chunk[5] << 8);
+            Delta = (Chunk[6] & CAPTURE_DELTA) != 0;
+
+            if (Width > DECODE_MAX_WIDTH || Height > DECODE_MAX_HEIGHT) {
+                fprintf(stderr, "frame %d: %d x %d is too big\n", Frame, Width, Height);
+                HaveKeyFrame = 0;
+                continue;
+            }
+            if (!Delta) {
+                ImageWidth = Width;
+                ImageHeight = Height;
+                memset(Image, 0, sizeof(Image));
+                HaveKeyFrame = 1;
+            }
+        }
+        else if (Type == CAPTURE_ROW && Length >= 2 && HaveKeyFrame) {
+            if (!DecodeRow(Chunk, Length, Delta)) {
+                BadChunks++;
+            }
+        }
+        else if (Type == CAPTURE_END && HaveKeyFrame) {
+            sprintf(FileName, "%.200s_%04d.ppm", Prefix, Frame);
+            if (SavePPM(FileName)) {
+                printf("%s\n", FileName);
+                Frames++;
+            }
+        }
+    }
+
+    printf("%d frames, %lu bad chunks\n", Frames, BadChunks);
+    fclose(fp);
+    return 0;
+}
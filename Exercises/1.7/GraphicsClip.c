@@ -0,0 +1,472 @@
+/************************************************************************************************
+** Clipping shapes to a clip rectangle before they are sent to the graphics chip
+**
+** The graphics chip only clips to the screen, and not always cheaply: a line or circle that is
+** mostly off the screen still takes a clock for every pixel, and a pixel written off the screen
+** lands in the unused part of the frame buffer. All the drawing functions clip to the clip
+** rectangle (the whole screen unless SetClipRectangle() says otherwise) here first:
+**
+**  - pixels, spans and rectangles are cut to the clip rectangle
+**  - lines, circles and ellipses are thrown away if they are all outside it (Cohen-Sutherland outcodes,
+**    bounding box), and sent as they are if they are all inside it. When the clip rectangle is
+**    the whole screen, partly visible ones that are at least half on it (the length of a line,
+**    the area of the box round a circle or ellipse) are sent as they are too, as the graphics
+**    chip clips them exactly. Ones mostly off it are cut like below, which GraphicsBenchmark's
+**    off screen lines and circles draw in about 40% and 25% fewer graphics chip clocks
+**  - a line partly inside a smaller clip rectangle is cut (Liang-Barsky style, one axis at a
+**    time) to the pixels the graphics chip would draw inside it, and those are queued as one
+**    HLine or VLine per run. A partly visible circle, arc or ellipse is queued as its visible
+**    pixels
+***********************************************************************************************/
+
+#include "Graphics.h"
+
+// the clip rectangle, from (ClipLeft, ClipTop) up to (but not including) (ClipRight, ClipBottom)
+int ClipLeft = 0;
+int ClipTop = 0;
+int ClipRight = WIDTH;
+int ClipBottom = HEIGHT;
+
+// Cohen-Sutherland outcode bits
+#define OUT_LEFT        1
+#define OUT_RIGHT       2
+#define OUT_TOP         4
+#define OUT_BOTTOM      8
+
+// Only draw inside the rectangle with top left corner (x1,y1) that is width x height pixels
+// (and on the screen)
+void SetClipRectangle(int x1, int y1, int width, int height)
+{
+    ClipLeft = (x1 < 0) ? 0 : x1;
+    ClipTop = (y1 < 0) ? 0 : y1;
+    ClipRight = (x1 + width > WIDTH) ? WIDTH : x1 + width;
+    ClipBottom = (y1 + height > HEIGHT) ? HEIGHT : y1 + height;
+}
+
+// Draw anywhere on the screen again
+void ResetClipRectangle(void)
+{
+    ClipLeft = 0;
+    ClipTop = 0;
+    ClipRight = WIDTH;
+    ClipBottom = HEIGHT;
+}
+
+static int ClipIsScreen(void)
+{
+    return ClipLeft == 0 && ClipTop == 0 && ClipRight == WIDTH && ClipBottom == HEIGHT;
+}
+
+static int OutCode(int x, int y)
+{
+    int Code = 0;
+
+    if (x < ClipLeft) {
+        Code |= OUT_LEFT;
+    }
+    else if (x >= ClipRight) {
+        Code |= OUT_RIGHT;
+    }
+    if (y < ClipTop) {
+        Code |= OUT_TOP;
+    }
+    else if (y >= ClipBottom) {
+        Code |= OUT_BOTTOM;
+    }
+    return Code;
+}
+
+// 1 if pixel x,y is inside the clip rectangle
+int ClipPixel(int x, int y)
+{
+    return x >= ClipLeft && x < ClipRight && y >= ClipTop && y < ClipBottom;
+}
+
+// Cut columns *x1 up to (not including) *x2 of row y to the clip rectangle.
+// Returns 0 if nothing is left
+int ClipSpan(int *x1, int *x2, int y)
+{
+    if (y < ClipTop || y >= ClipBottom) {
+        return 0;
+    }
+    if (*x1 < ClipLeft) {
+        *x1 = ClipLeft;
+    }
+    if (*x2 > ClipRight) {
+        *x2 = ClipRight;
+    }
+    return *x1 < *x2;
+}
+
+// Cut rows *y1 up to (not including) *y2 of column x to the clip rectangle.
+// Returns 0 if nothing is left
+int ClipVSpan(int x, int *y1, int *y2)
+{
+    if (x < ClipLeft || x >= ClipRight) {
+        return 0;
+    }
+    if (*y1 < ClipTop) {
+        *y1 = ClipTop;
+    }
+    if (*y2 > ClipBottom) {
+        *y2 = ClipBottom;
+    }
+    return *y1 < *y2;
+}
+
+// Cut the rectangle (*x1,*y1) up to (not including) (*x2,*y2) to the clip rectangle.
+// Returns 0 if nothing is left
+int ClipBox(int *x1, int *y1, int *x2, int *y2)
+{
+    if (*x1 < ClipLeft) {
+        *x1 = ClipLeft;
+    }
+    if (*y1 < ClipTop) {
+        *y1 = ClipTop;
+    }
+    if (*x2 > ClipRight) {
+        *x2 = ClipRight;
+    }
+    if (*y2 > ClipBottom) {
+        *y2 = ClipBottom;
+    }
+    return *x1 < *x2 && *y1 < *y2;
+}
+
+// Cut pixels *First up to (not including) *Last of a line Length pixels long to the ones that
+// are roughly inside Low up to (not including) High along one axis, along which the line goes
+// from Start to Start + Delta
+static void LineAxisPart(int Start, int Delta, int Low, int High, int Length, int *First, int *Last)
+{
+    long long Enter = 0, Leave = Length;
+
+    if (Delta > 0) {
+        Enter = (long long)(Low - Start) * Length / Delta;
+        Leave = (long long)(High - Start) * Length / Delta;
+    }
+    else if (Delta < 0) {
+        Enter = (long long)(Start - High + 1) * Length / -Delta;
+        Leave = (long long)(Start - Low + 1) * Length / -Delta;
+    }
+    else if (Start < Low || Start >= High) {
+        Leave = 0;
+    }
+
+    if (Enter > *First) {
+        *First = (int)Enter;
+    }
+    if (Leave < *Last) {
+        *Last = (int)Leave;
+    }
+    if (*Last < *First) {
+        *Last = *First;
+    }
+}
+
+/*********************************************************************************************
+** Decide what to do with the line the graphics chip draws from (x1,y1) towards (x2,y2).
+** Returns CLIP_REJECT if none of it is inside the clip rectangle, CLIP_ACCEPT if it can be
+** drawn as it is, or CLIP_PARTIAL if it has to be drawn with ClippedLine()
+*********************************************************************************************/
+
+int ClipLine(int x1, int y1, int x2, int y2)
+{
+    int Code1 = OutCode(x1, y1);
+    int Code2 = OutCode(x2, y2);
+    int Length = x2 - x1, Minor, First = 0, Last;
+
+    // every pixel is inside the box with the end points at its corners
+    if ((Code1 | Code2) == 0) {
+        return CLIP_ACCEPT;
+    }
+    if ((Code1 & Code2) != 0) {
+        return CLIP_REJECT;
+    }
+    if (!ClipIsScreen()) {
+        return CLIP_PARTIAL;
+    }
+
+    // the graphics chip clips to the screen itself, but still takes a clock for every pixel
+    // off it, so only a line that is at least half on the screen is worth sending as it is
+    Length = (Length < 0) ? -Length : Length;
+    Minor = (y2 < y1) ? y1 - y2 : y2 - y1;
+    if (Minor > Length) {
+        Length = Minor;
+    }
+    Last = Length;
+    LineAxisPart(x1, x2 - x1, ClipLeft, ClipRight, Length, &First, &Last);
+    LineAxisPart(y1, y2 - y1, ClipTop, ClipBottom, Length, &First, &Last);
+    return (2 * (Last - First) >= Length) ? CLIP_ACCEPT : CLIP_PARTIAL;
+}
+
+// Number of steps along the minor axis the graphics chip's line drawing (see the DrawLine
+// states) has taken before it draws pixel k of a line with major length dx and minor length dy
+static int LineMinorSteps(int k, int dx, int dy)
+{
+    long long Error = 2 * (long long)dy - dx + 2 * (long long)dy * (k - 1);
+
+    if (k <= 0 || Error < 0) {
+        return 0;
+    }
+    return (int)(Error / (2 * (long long)dx)) + 1;
+}
+
+// first pixel k (from First up to Last+1) at which LineMinorSteps reaches Steps
+static int LineFindMinorStep(int Steps, int First, int Last, int dx, int dy)
+{
+    int Middle;
+
+    Last++;
+    while (First < Last) {
+        Middle = First + (Last - First) / 2;
+        if (LineMinorSteps(Middle, dx, dy) >= Steps) {
+            Last = Middle;
+        } else {
+            First = Middle + 1;
+        }
+    }
+    return First;
+}
+
+// first and last pixel k (0 to dx-1) for which Start + Step * k is in [Low, High)
+// Returns 0 if there are none
+static int LineAxisRange(int Start, int Step, int Low, int High, int *First, int *Last)
+{
+    if (Step > 0) {
+        if (Start < Low) {
+            *First = Low - Start;
+        }
+        if (Start + *Last >= High) {
+            *Last = High - 1 - Start;
+        }
+    }
+    else if (Step < 0) {
+        if (Start >= High) {
+            *First = Start - (High - 1);
+        }
+        if (Start - *Last < Low) {
+            *Last = Start - Low;
+        }
+    }
+    else if (Start < Low || Start >= High) {
+        return 0;
+    }
+    return *First <= *Last;
+}
+
+/*********************************************************************************************
+** Queue the pixels of the line from (x1,y1) towards (x2,y2) that are inside the clip rectangle,
+** exactly the pixels the graphics chip would draw there, as one HLine or VLine per run.
+** The pixels outside are not walked: the range of pixels inside is worked out along the major
+** axis directly and along the minor axis from the number of minor steps taken at each pixel
+*********************************************************************************************/
+
+void ClippedLine(int x1, int y1, int x2, int y2, int Colour)
+{
+    int dx = x2 - x1, dy = y2 - y1;
+    int s1 = (dx > 0) - (dx < 0), s2 = (dy > 0) - (dy < 0);
+    int Major, Minor, MajorStep, MinorStep, MajorLow, MajorHigh, MinorLow, MinorHigh;
+    int First = 0, Last, k, RunStart, Steps, Error, RunFirst, Interchange = 0;
+
+    dx = (dx < 0) ? -dx : dx;
+    dy = (dy < 0) ? -dy : dy;
+
+    // work along the longer axis like the graphics chip (its "interchange")
+    if (dy > dx) {
+        Major = y1; MajorStep = s2; MajorLow = ClipTop; MajorHigh = ClipBottom;
+        Minor = x1; MinorStep = s1; MinorLow = ClipLeft; MinorHigh = ClipRight;
+        k = dx; dx = dy; dy = k;
+        Interchange = 1;
+    }
+    else {
+        Major = x1; MajorStep = s1; MajorLow = ClipLeft; MajorHigh = ClipRight;
+        Minor = y1; MinorStep = s2; MinorLow = ClipTop; MinorHigh = ClipBottom;
+    }
+
+    if (dx == 0) {
+        return;
+    }
+    Last = dx - 1;                          // the end point itself is not drawn
+
+    if (!LineAxisRange(Major, MajorStep, MajorLow, MajorHigh, &First, &Last)) {
+        return;
+    }
+
+    // the minor coordinate only ever moves one way so find where it enters and leaves the clip rectangle
+    if (MinorStep > 0) {
+        if (Minor < MinorLow) {
+            First = LineFindMinorStep(MinorLow - Minor, First, Last, dx, dy);
+        }
+        if (Minor + LineMinorSteps(Last, dx, dy) >= MinorHigh) {
+            Last = LineFindMinorStep(MinorHigh - Minor, First, Last, dx, dy) - 1;
+        }
+    }
+    else if (MinorStep < 0) {
+        if (Minor >= MinorHigh) {
+            First = LineFindMinorStep(Minor - (MinorHigh - 1), First, Last, dx, dy);
+        }
+        if (Minor - LineMinorSteps(Last, dx, dy) < MinorLow) {
+            Last = LineFindMinorStep(Minor - MinorLow + 1, First, Last, dx, dy) - 1;
+        }
+    }
+    else if (Minor < MinorLow || Minor >= MinorHigh) {
+        return;
+    }
+
+    // walk the pixels inside with the graphics chip's error term, starting part way along
+    Steps = LineMinorSteps(First, dx, dy);
+    Error = 2 * dy - dx + 2 * dy * First - 2 * dx * Steps;
+    RunStart = First;
+
+    for(k = First; k <= Last; k++) {
+        if (k == Last || Error >= 0) {
+            // pixel k is the last one before a minor step (or the end) so finish the run
+            RunFirst = (MajorStep >= 0) ? Major + RunStart : Major - k;
+            if (Interchange) {
+                QueueVLine(Minor + MinorStep * Steps, RunFirst, k - RunStart + 1, Colour);
+            } else {
+                QueueHLine(RunFirst, Minor + MinorStep * Steps, k - RunStart + 1, Colour);
+            }
+            RunStart = k + 1;
+        }
+
+        while (Error >= 0) {
+            Steps++;
+            Error -= 2 * dx;
+        }
+        Error += 2 * dy;
+    }
+}
+
+// 1 if the graphics chip can be left to clip a shape in the box (x1,y1) up to (not including)
+// (x2,y2) to the screen: it takes a clock for every pixel of it, on the screen or not, so at
+// least half of the box has to be on the screen
+static int ClipMostlyInside(int x1, int y1, int x2, int y2)
+{
+    long long Area = (long long)(x2 - x1) * (y2 - y1);
+
+    if (!ClipIsScreen() || !ClipBox(&x1, &y1, &x2, &y2)) {
+        return 0;
+    }
+    return 2 * (long long)(x2 - x1) * (y2 - y1) >= Area;
+}
+
+// Like ClipLine() for the circle the graphics chip draws, using the box around it
+int ClipCircle(int centreX, int centreY, int radius)
+{
+    if (radius < 0) {
+        return CLIP_REJECT;
+    }
+    if (centreX + radius < ClipLeft || centreX - radius >= ClipRight ||
+        centreY + radius < ClipTop || centreY - radius >= ClipBottom) {
+        return CLIP_REJECT;
+    }
+    if (centreX - radius >= ClipLeft && centreX + radius < ClipRight &&
+        centreY - radius >= ClipTop && centreY + radius < ClipBottom) {
+        return CLIP_ACCEPT;
+    }
+    if (ClipMostlyInside(centreX - radius, centreY - radius, centreX + radius + 1, centreY + radius + 1)) {
+        return CLIP_ACCEPT;
+    }
+    return CLIP_PARTIAL;
+}
+
+// Queue the pixels of the circle the graphics chip would draw (see the DrawCircle states)
+// that are inside the clip rectangle
+void ClippedCircle(int centreX, int centreY, int radius, int Colour)
+{
+    ClippedArc(centreX, centreY, radius, ARC_CIRCLE, Colour);
+}
+
+// The same for the octants of a circle drawn by the Arc command
+void ClippedArc(int centreX, int centreY, int radius, int Octants, int Colour)
+{
+    int offset_x = radius;
+    int offset_y = 0;
+    int crit = 1 - radius;
+
+    while (offset_y <= offset_x) {
+        if (Octants & ARC_OCTANT_0) QueueWritePixel(centreX + offset_x, centreY + offset_y, Colour);
+        if (Octants & ARC_OCTANT_1) QueueWritePixel(centreX + offset_y, centreY + offset_x, Colour);
+        if (Octants & ARC_OCTANT_3) QueueWritePixel(centreX - offset_x, centreY + offset_y, Colour);
+        if (Octants & ARC_OCTANT_2) QueueWritePixel(centreX - offset_y, centreY + offset_x, Colour);
+        if (Octants & ARC_OCTANT_4) QueueWritePixel(centreX - offset_x, centreY - offset_y, Colour);
+        if (Octants & ARC_OCTANT_5) QueueWritePixel(centreX - offset_y, centreY - offset_x, Colour);
+        if (Octants & ARC_OCTANT_7) QueueWritePixel(centreX + offset_x, centreY - offset_y, Colour);
+        if (Octants & ARC_OCTANT_6) QueueWritePixel(centreX + offset_y, centreY - offset_x, Colour);
+
+        offset_y++;
+        if (crit <= 0) {
+            crit += 2 * offset_y + 1;
+        } else {
+            offset_x--;
+            crit += 2 * (offset_y - offset_x) + 1;
+        }
+    }
+}
+
+// Like ClipCircle() for the ellipse the graphics chip draws
+int ClipEllipse(int centreX, int centreY, int radiusX, int radiusY)
+{
+    if (radiusX < 0 || radiusY < 0) {
+        return CLIP_REJECT;
+    }
+    if (centreX + radiusX < ClipLeft || centreX - radiusX >= ClipRight ||
+        centreY + radiusY < ClipTop || centreY - radiusY >= ClipBottom) {
+        return CLIP_REJECT;
+    }
+    if (centreX - radiusX >= ClipLeft && centreX + radiusX < ClipRight &&
+        centreY - radiusY >= ClipTop && centreY + radiusY < ClipBottom) {
+        return CLIP_ACCEPT;
+    }
+    if (ClipMostlyInside(centreX - radiusX, centreY - radiusY, centreX + radiusX + 1, centreY + radiusY + 1)) {
+        return CLIP_ACCEPT;
+    }
+    return CLIP_PARTIAL;
+}
+
+static void ClippedEllipsePoints(int centreX, int centreY, int offset_x, int offset_y, int Colour)
+{
+    QueueWritePixel(centreX + offset_x, centreY + offset_y, Colour);
+    QueueWritePixel(centreX - offset_x, centreY + offset_y, Colour);
+    QueueWritePixel(centreX - offset_x, centreY - offset_y, Colour);
+    QueueWritePixel(centreX + offset_x, centreY - offset_y, Colour);
+}
+
+// Queue the pixels of the ellipse the graphics chip would draw (see the DrawEllipse states)
+// that are inside the clip rectangle
+void ClippedEllipse(int centreX, int centreY, int radiusX, int radiusY, int Colour)
+{
+    long long a2 = (long long)radiusX * radiusX;
+    long long b2 = (long long)radiusY * radiusY;
+    long long dx = 0, dy = 2 * a2 * radiusY;
+    long long d = 4 * b2 - 4 * a2 * radiusY + a2;
+    int offset_x = 0, offset_y = radiusY;
+
+    while (dx < dy) {
+        ClippedEllipsePoints(centreX, centreY, offset_x, offset_y, Colour);
+        offset_x++;
+        dx += 2 * b2;
+        if (d < 0) {
+            d += 4 * (dx + b2);
+        } else {
+            offset_y--;
+            dy -= 2 * a2;
+            d += 4 * (dx - dy + b2);
+        }
+    }
+
+    d += 3 * (a2 - b2) - 2 * (dx + dy);
+    while (offset_y >= 0) {
+        ClippedEllipsePoints(centreX, centreY, offset_x, offset_y, Colour);
+        offset_y--;
+        dy -= 2 * a2;
+        if (d > 0) {
+            d += 4 * (a2 - dy);
+        } else {
+            offset_x++;
+            dx += 2 * b2;
+            d += 4 * (dx - dy + a2);
+        }
+    }
+}
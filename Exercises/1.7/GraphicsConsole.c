@@ -0,0 +1,271 @@
+/************************************************************************************************
+** Scrolling text console
+**
+** Putting text on the screen is split into three steps so that none of them waits:
+**
+**  - ConsolePoll() moves whatever the UART has received into the console's input ring. It only
+**    reads registers, so it can be called as often as needed to keep up with the port
+**  - the bytes in the input ring are then written into Text, the characters that should be on
+**    the screen. Its rows are a ring, so a new line at the bottom moves no text, it just counts
+**    one more row that the screen has to be scrolled by
+**  - the screen is brought up to date from Shown, a copy of the characters it shows: all the
+**    rows scrolled since last time are scrolled at once with one CopyRect(), then only the
+**    characters that differ from Shown are redrawn, a background rectangle for each run of them
+**    and the runs of each character's font
+**
+** CopyRect() waits for the graphics chip, so scrolling is left until the next ConsoleUpdate()
+** if it is busy, and no more is queued than the command queue has room for. Text that arrives
+** faster than it can be drawn piles up in Text and is drawn in one go when the graphics chip
+** catches up, so scrolling costs at most one copy per update however many lines came in
+***********************************************************************************************/
+
+#include <string.h>
+
+#include "Graphics.h"
+#include "GraphicsConsole.h"
+#include "RS232.h"
+
+// most commands ConsoleUpdate() leaves in the command queue, so queuing never has to wait for room
+#define CONSOLE_QUEUE_LIMIT     (GRAPHICS_QUEUE_SIZE / 2)
+
+// in Shown for a character cell whose contents are not known, so it is always redrawn
+#define CONSOLE_UNKNOWN         0
+
+// row Row of Text counted from the top of the console
+static char *TextRow(Console *c, int Row)
+{
+    return c->Text[(c->Top + Row) % c->Rows];
+}
+
+/*********************************************************************************************
+** Set up a console of Columns x Rows characters with its top left corner at x,y and clear it.
+** Each character takes a cell the width of the font's characters plus their spacing, and its
+** height plus a row between lines, times Scale. A fixed width font such as Font5x7 looks best
+*********************************************************************************************/
+
+void ConsoleInit(Console *c, int x, int y, int Columns, int Rows, const Font *TextFont, int Scale,
+    int Colour, int BackgroundColour)
+{
+    int Row;
+
+    memset(c, 0, sizeof(*c));
+    if (Columns > CONSOLE_MAX_COLUMNS) {
+        Columns = CONSOLE_MAX_COLUMNS;
+    }
+    if (Rows > CONSOLE_MAX_ROWS) {
+        Rows = CONSOLE_MAX_ROWS;
+    }
+    if (Scale < 1) {
+        Scale = 1;
+    }
+
+    c->x = x;
+    c->y = y;
+    c->Columns = Columns;
+    c->Rows = Rows;
+    c->TextFont = TextFont;
+    c->Scale = Scale;
+    c->CellWidth = (TextFont->Data->Width + TextFont->Data->Spacing) * Scale;
+    c->CellHeight = (TextFont->Data->Height + 1) * Scale;
+    c->Colour = Colour;
+    c->BackgroundColour = BackgroundColour;
+
+    for(Row = 0; Row < Rows; Row++) {
+        memset(c->Text[Row], ' ', Columns);
+        memset(c->Shown[Row], ' ', Columns);
+    }
+    QueueFilledRectangle(x, y, Columns * c->CellWidth, Rows * c->CellHeight, BackgroundColour);
+}
+
+// Add a byte to the input ring, e.g. from a log message. It is lost if the ring is full
+void ConsolePutChar(Console *c, int Char)
+{
+    if (c->InputTail - c->InputHead >= CONSOLE_INPUT_SIZE) {
+        c->Dropped++;
+        return;
+    }
+    c->Input[c->InputTail++ % CONSOLE_INPUT_SIZE] = (unsigned char)Char;
+}
+
+void ConsoleWrite(Console *c, const char *String)
+{
+    while (*String != '\0') {
+        ConsolePutChar(c, (unsigned char)*String++);
+    }
+}
+
+/*********************************************************************************************
+** Move everything the UART has received into the input ring and return how many bytes that was.
+** The UART's FIFO holds 16 bytes, about 1.4ms at 115200 baud, so call this at least that often,
+** including from inside anything in the main loop that takes longer
+*********************************************************************************************/
+
+int ConsolePoll(Console *c)
+{
+    int Count = 0;
+
+    while (RS232TestForReceivedData()) {
+        ConsolePutChar(c, getcharRS232());
+        Count++;
+    }
+    return Count;
+}
+
+// Move the cursor to the start of the next row, scrolling Text up a row if it is on the last one
+static void NewLine(Console *c)
+{
+    c->CursorColumn = 0;
+    if (c->CursorRow < c->Rows - 1) {
+        c->CursorRow++;
+        return;
+    }
+
+    // the top row goes round to become the new bottom row
+    memset(c->Text[c->Top], ' ', c->Columns);
+    c->Top = (c->Top + 1) % c->Rows;
+    if (c->Scrolls < c->Rows) {
+        c->Scrolls++;
+    }
+}
+
+// Write one character at the cursor. A line that is full carries on on the next row
+static void PutText(Console *c, int Char)
+{
+    if (c->CursorColumn >= c->Columns) {
+        NewLine(c);
+    }
+    TextRow(c, c->CursorRow)[c->CursorColumn++] = (char)Char;
+}
+
+// Write everything in the input ring into Text
+static void TakeInput(Console *c)
+{
+    int Char, Row;
+
+    while (c->InputHead != c->InputTail) {
+        Char = c->Input[c->InputHead++ % CONSOLE_INPUT_SIZE];
+
+        if (Char == '\n') {
+            NewLine(c);
+        }
+        else if (Char == '\r') {
+            c->CursorColumn = 0;
+        }
+        else if (Char == '\b') {
+            if (c->CursorColumn > 0) {
+                c->CursorColumn--;
+            }
+        }
+        else if (Char == '\t') {
+            do {
+                PutText(c, ' ');
+            } while (c->CursorColumn % CONSOLE_TAB != 0 && c->CursorColumn < c->Columns);
+        }
+        else if (Char == '\f') {            // clear the console
+            for(Row = 0; Row < c->Rows; Row++) {
+                memset(c->Text[Row], ' ', c->Columns);
+            }
+            c->CursorRow = 0;
+            c->CursorColumn = 0;
+        }
+        else if (Char >= ' ' && Char < 0x7F) {
+            PutText(c, Char);
+        }
+    }
+}
+
+/*********************************************************************************************
+** Scroll the screen by the rows Text has scrolled by since last time. Returns 0 (and does
+** nothing) if the graphics chip is not idle yet, since CopyRect() would have to wait for it
+*********************************************************************************************/
+
+static int ScrollScreen(Console *c)
+{
+    int Row, Kept = c->Rows - c->Scrolls;
+
+    if (c->Scrolls == 0) {
+        return 1;
+    }
+    if (GraphicsQueueCount() != 0 || (GraphicsStatusReg & GRAPHICS_STATUS_IDLE) == 0) {
+        return 0;
+    }
+
+    if (Kept > 0) {
+        CopyRect(c->x, c->y + c->Scrolls * c->CellHeight, c->Columns * c->CellWidth, Kept * c->CellHeight,
+            c->x, c->y);
+        memmove(c->Shown[0], c->Shown[c->Scrolls], Kept * sizeof(c->Shown[0]));
+
+        // the rows that scrolled into view still show what was there before
+        for(Row = Kept; Row < c->Rows; Row++) {
+            memset(c->Shown[Row], CONSOLE_UNKNOWN, c->Columns);
+        }
+    }
+    else {
+        // everything has scrolled off, so one rectangle clears it
+        QueueFilledRectangle(c->x, c->y, c->Columns * c->CellWidth, c->Rows * c->CellHeight, c->BackgroundColour);
+        for(Row = 0; Row < c->Rows; Row++) {
+            memset(c->Shown[Row], ' ', c->Columns);
+        }
+    }
+
+    c->Scrolls = 0;
+    return 1;
+}
+
+// Redraw the characters that differ from Shown, until the command queue is half full
+static void DrawChanges(Console *c)
+{
+    int Row, Column, Start, i, x, y;
+    char *Text, *Shown, String[2] = { 0, 0 };
+
+    for(Row = 0; Row < c->Rows; Row++) {
+        Text = TextRow(c, Row);
+        Shown = c->Shown[Row];
+        if (memcmp(Text, Shown, c->Columns) == 0) {
+            continue;
+        }
+
+        y = c->y + Row * c->CellHeight;
+        for(Column = 0; Column < c->Columns; ) {
+            if (Text[Column] == Shown[Column]) {
+                Column++;
+                continue;
+            }
+            if (GraphicsQueueCount() >= CONSOLE_QUEUE_LIMIT) {
+                return;
+            }
+
+            // clear the cells of the whole run of changed characters with one rectangle
+            for(Start = Column; Column < c->Columns && Text[Column] != Shown[Column]; Column++) {
+            }
+            QueueFilledRectangle(c->x + Start * c->CellWidth, y, (Column - Start) * c->CellWidth, c->CellHeight,
+                c->BackgroundColour);
+
+            // then draw them. If the queue fills up first the rest are left blank for next time
+            for(i = Start; i < Column; i++) {
+                if (Text[i] == ' ' || GraphicsQueueCount() >= CONSOLE_QUEUE_LIMIT) {
+                    Shown[i] = ' ';
+                    continue;
+                }
+                x = c->x + i * c->CellWidth;
+                String[0] = Text[i];
+                DrawString(c->TextFont, x, y, String, c->Scale, c->Colour, FONT_TRANSPARENT);
+                Shown[i] = Text[i];
+            }
+        }
+    }
+}
+
+/*********************************************************************************************
+** Read the UART, take in everything waiting in the input ring and bring the screen up to date
+** as far as can be done without waiting for the graphics chip. Call it from the main loop
+*********************************************************************************************/
+
+void ConsoleUpdate(Console *c)
+{
+    ConsolePoll(c);
+    TakeInput(c);
+    if (ScrollScreen(c)) {
+        DrawChanges(c);
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef GRAPHICS_CONSOLE_H
+#define GRAPHICS_CONSOLE_H
+
+#include "GraphicsFont.h"
+
+/************************************************************************************************
+** Scrolling text console (GraphicsConsole.c)
+**
+** A grid of characters on the LCD, written to like a terminal, e.g. to see log output when the
+** board has no host attached. Bytes come from the RS232 port (ConsolePoll) or from the program
+** (ConsolePutChar, ConsoleWrite) into an input ring, and ConsoleUpdate() puts them on the screen
+** without ever waiting for the graphics chip, so both can be called from the main loop
+***********************************************************************************************/
+
+// biggest console: the whole screen in the 6 x 8 pixel cells of Font5x7 (WIDTH and HEIGHT are in Graphics.h)
+#define CONSOLE_MAX_COLUMNS     (WIDTH / 6)
+#define CONSOLE_MAX_ROWS        (HEIGHT / 8)
+
+// bytes waiting to be put on the screen (a power of 2). At 115200 baud this is about a third of
+// a second of solid input, so the screen can fall that far behind without losing anything
+#define CONSOLE_INPUT_SIZE      4096
+
+// tab stops every this many columns
+#define CONSOLE_TAB             8
+
+typedef struct {
+    int x, y, Columns, Rows;            // top left corner on the screen, and size in characters
+    int CellWidth, CellHeight;          // pixels each character takes
+    const Font *TextFont;
+    int Scale;
+    int Colour, BackgroundColour;
+
+    // what should be on the screen. The rows are a ring starting at row Top, so scrolling moves no text
+    char Text[CONSOLE_MAX_ROWS][CONSOLE_MAX_COLUMNS];
+    int Top;
+    int CursorRow, CursorColumn;        // where the next character goes, CursorRow counted from the top
+
+    // what is on the screen, row 0 at the top, and rows Text has scrolled by since the screen was scrolled
+    char Shown[CONSOLE_MAX_ROWS][CONSOLE_MAX_COLUMNS];
+    int Scrolls;
+
+    unsigned char Input[CONSOLE_INPUT_SIZE];
+    unsigned int InputHead, InputTail;  // next byte to take out, next free place
+    unsigned long Dropped;              // bytes lost because the input ring was full
+} Console;
+
+void ConsoleInit(Console *c, int x, int y, int Columns, int Rows, const Font *TextFont, int Scale,
+    int Colour, int BackgroundColour);
+void ConsolePutChar(Console *c, int Char);
+void ConsoleWrite(Console *c, const char *String);
+int ConsolePoll(Console *c);
+void ConsoleUpdate(Console *c);
+
+#endif
@@ -0,0 +1,115 @@
+/************************************************************************************************
+** Flood fill
+**
+** FloodFill() reads the screen from the shadow frame buffer (GraphicsShadow.c) rather than with a
+** GetAPixel command per pixel, and fills the region one span (row) at a time, queuing an HLine
+** for each. The HLine is drawn into the shadow as soon as it is queued, so a filled span is never
+** looked at again.
+**
+** Spans still to look at are kept on a fixed size stack instead of recursing (scanline seed fill,
+** after Heckbert in Graphics Gems): each entry is a span that has been filled and the direction
+** of the row next to it that has to be searched. Parts of a new span that stick out past the
+** span it was found from are searched in the other direction too, which is how the fill gets
+** round corners and into U shapes
+***********************************************************************************************/
+
+#include "Graphics.h"
+
+// spans waiting to be searched. Even very ragged regions rarely need more than a few hundred
+#define FILL_STACK_SIZE         4096
+
+typedef struct {
+    short int y, Left, Right;           // columns Left to Right (inclusive) of row y are filled
+    short int Direction;                // search row y + Direction next
+} FillSpan;
+
+static FillSpan FillStack[FILL_STACK_SIZE];
+static int FillStackSize;
+static int FillOverflow;
+
+static void FillPush(int y, int Left, int Right, int Direction)
+{
+    if (y + Direction < ClipTop || y + Direction >= ClipBottom) {
+        return;
+    }
+    if (FillStackSize >= FILL_STACK_SIZE) {
+        FillOverflow = 1;
+        return;
+    }
+    FillStack[FillStackSize].y = (short int)y;
+    FillStack[FillStackSize].Left = (short int)Left;
+    FillStack[FillStackSize].Right = (short int)Right;
+    FillStack[FillStackSize].Direction = (short int)Direction;
+    FillStackSize++;
+}
+
+/*********************************************************************************************
+** Fill the region of pixels that are the same colour as (x,y) and joined to it up, down, left
+** or right, inside the clip rectangle, with colour Colour.
+** The shadow frame buffer is turned on first if it is not already on, which reads the whole
+** screen back from the graphics chip, so it is best turned on once at the start.
+** Returns 0 if the stack ran out and only part of the region was filled, otherwise 1
+*********************************************************************************************/
+
+int FloodFill(int x, int y, int Colour)
+{
+    FillSpan Span;
+    int Old, Left, Right, Row;
+    unsigned char *Pixels;
+
+    if (!ClipPixel(x, y)) {
+        return 1;
+    }
+    if (!GraphicsShadowEnabled) {
+        GraphicsShadowEnable();
+    }
+
+    Old = GraphicsShadow[y][x];
+    if (Old == (Colour & 0xFF)) {
+        return 1;
+    }
+
+    FillStackSize = 0;
+    FillOverflow = 0;
+    FillPush(y, x, x, 1);               // row y + 1 from column x ...
+    FillPush(y + 1, x, x, -1);          // ... and row y itself
+
+    while (FillStackSize > 0) {
+        Span = FillStack[--FillStackSize];
+        Row = Span.y + Span.Direction;
+        Pixels = GraphicsShadow[Row];
+
+        x = Span.Left;
+        while (x <= Span.Right) {
+            // skip what is not part of the region
+            while (x <= Span.Right && Pixels[x] != Old) {
+                x++;
+            }
+            if (x > Span.Right) {
+                break;
+            }
+
+            // the span of the region that x is in, which can carry on either side of the parent
+            Left = x;
+            while (Left > ClipLeft && Pixels[Left - 1] == Old) {
+                Left--;
+            }
+            Right = x;
+            while (Right + 1 < ClipRight && Pixels[Right + 1] == Old) {
+                Right++;
+            }
+            QueueSpan(Left, Right + 1, Row, Colour);
+
+            FillPush(Row, Left, Right, Span.Direction);
+            if (Left < Span.Left) {
+                FillPush(Row, Left, Span.Left - 1, -Span.Direction);
+            }
+            if (Right > Span.Right) {
+                FillPush(Row, Span.Right + 1, Right, -Span.Direction);
+            }
+            x = Right + 2;              // Right + 1 is not part of the region
+        }
+    }
+
+    return !FillOverflow;
+}
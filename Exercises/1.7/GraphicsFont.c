@@ -0,0 +1,140 @@
+/************************************************************************************************
+** Drawing text with bitmap fonts
+**
+** FontLoad() works out once for each character the runs of set pixels on each of its rows and
+** how far to move on after it. DrawString() then queues one command per run, and fills the
+** background of the whole string with one FilledRectangle first if asked to. Characters scaled
+** up by Scale draw each run as a Scale x Scale block, still one command per run
+***********************************************************************************************/
+
+#include "Graphics.h"
+#include "GraphicsFont.h"
+
+/*********************************************************************************************
+** Turn the bitmaps in Data into runs in font. Characters outside the font, or past
+** FONT_MAX_CHARS, are drawn as nothing and take no space.
+** Returns 1 if the font was loaded or 0 if it has too many runs (or is too tall)
+*********************************************************************************************/
+
+int FontLoad(Font *font, const FontData *Data)
+{
+    const unsigned char *Bitmap;
+    int c, Column, Row, First, Last, Start = 0, NumRuns = 0;
+
+    if (Data->Height > 8) {
+        return 0;
+    }
+
+    font->Data = Data;
+    for(c = 0; c < FONT_MAX_CHARS; c++) {
+        font->FirstRun[c] = NumRuns;
+        font->Advance[c] = 0;
+
+        if (c < Data->FirstChar || c >= Data->FirstChar + Data->NumChars) {
+            continue;
+        }
+        Bitmap = Data->Columns + (c - Data->FirstChar) * Data->Width;
+
+        // columns of the bitmap we use
+        First = 0;
+        Last = Data->Width - 1;
+        if (Data->Proportional) {
+            while (First <= Last && Bitmap[First] == 0) {
+                First++;
+            }
+            while (Last >= First && Bitmap[Last] == 0) {
+                Last--;
+            }
+        }
+
+        if (First > Last) {
+            font->Advance[c] = (Data->Proportional ? Data->SpaceWidth : Data->Width) + Data->Spacing;
+            continue;
+        }
+        font->Advance[c] = Last - First + 1 + Data->Spacing;
+
+        for(Row = 0; Row < Data->Height; Row++) {
+            for(Column = First; Column <= Last + 1; Column++) {
+                if (Column <= Last && (Bitmap[Column] >> Row) & 1) {
+                    if (Column == First || !((Bitmap[Column - 1] >> Row) & 1)) {
+                        Start = Column;
+                    }
+                }
+                else if (Column > First && (Bitmap[Column - 1] >> Row) & 1) {
+                    if (NumRuns >= FONT_MAX_RUNS) {
+                        return 0;
+                    }
+                    font->Runs[NumRuns].x = Start - First;
+                    font->Runs[NumRuns].y = Row;
+                    font->Runs[NumRuns].Length = Column - Start;
+                    NumRuns++;
+                }
+            }
+        }
+    }
+    font->FirstRun[FONT_MAX_CHARS] = NumRuns;
+
+    return 1;
+}
+
+int FontHeight(const Font *font, int Scale)
+{
+    return font->Data->Height * Scale;
+}
+
+// width in pixels of String, from the cached character widths. There is no space after the last character
+int FontStringWidth(const Font *font, const char *String, int Scale)
+{
+    int Width = 0;
+    unsigned char c;
+
+    for(; (c = (unsigned char)*String) != 0; String++) {
+        if (c < FONT_MAX_CHARS) {
+            Width += font->Advance[c];
+        }
+    }
+    if (Width > 0) {
+        Width -= font->Data->Spacing;
+    }
+    return Width * Scale;
+}
+
+/*********************************************************************************************
+** Draw String with its top left corner at x,y, each pixel of the font Scale x Scale pixels.
+** If BackgroundColour is not FONT_TRANSPARENT the box the string fills is cleared to it first.
+** The commands go through the command queue, so this returns before the text is drawn
+*********************************************************************************************/
+
+void DrawString(const Font *font, int x, int y, const char *String, int Scale, int Colour, int BackgroundColour)
+{
+    const FontRun *Run, *End;
+    unsigned char c;
+    int RunX, RunY;
+
+    if (Scale < 1) {
+        Scale = 1;
+    }
+
+    if (BackgroundColour != FONT_TRANSPARENT) {
+        QueueFilledRectangle(x, y, FontStringWidth(font, String, Scale), FontHeight(font, Scale), BackgroundColour);
+    }
+
+    for(; (c = (unsigned char)*String) != 0; String++) {
+        if (c >= FONT_MAX_CHARS) {
+            continue;
+        }
+
+        End = &font->Runs[font->FirstRun[c + 1]];
+        for(Run = &font->Runs[font->FirstRun[c]]; Run < End; Run++) {
+            RunX = x + Run->x * Scale;
+            RunY = y + Run->y * Scale;
+            if (Scale == 1) {
+                QueueSpan(RunX, RunX + Run->Length, RunY, Colour);
+            }
+            else {
+                QueueFilledRectangle(RunX, RunY, Run->Length * Scale, Scale, Colour);
+            }
+        }
+        x += font->Advance[c] * Scale;
+    }
+}
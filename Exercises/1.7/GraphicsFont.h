@@ -0,0 +1,52 @@
+#ifndef GRAPHICS_FONT_H
+#define GRAPHICS_FONT_H
+
+/************************************************************************************************
+** Bitmap fonts (GraphicsFont.c)
+**
+** A font is described by a FontData (see FontData.c) and has to be loaded into a Font before it
+** can be drawn. Loading turns every character into the horizontal runs of pixels it is made of,
+** so drawing a string is one HLine per run instead of one WriteAPixel per pixel
+***********************************************************************************************/
+
+// most characters and runs (of all the characters together) a font can have
+#define FONT_MAX_CHARS          128
+#define FONT_MAX_RUNS           4096
+
+// colour to give DrawString for no background
+#define FONT_TRANSPARENT        -1
+
+typedef struct {
+    int Height;                         // rows in each character, up to 8
+    int Width;                          // columns in each character's bitmap
+    int FirstChar;                      // the character the first bitmap is for
+    int NumChars;
+    int Spacing;                        // blank columns between characters
+    int Proportional;                   // leave out blank columns either side of each character
+    int SpaceWidth;                     // width of a blank character when Proportional
+    const unsigned char *Columns;       // Width bytes per character, one per column, bit 0 at the top
+} FontData;
+
+typedef struct {
+    signed char x, y;                   // where the run starts, from the top left of the character
+    unsigned char Length;
+} FontRun;
+
+typedef struct {
+    const FontData *Data;
+    unsigned char Advance[FONT_MAX_CHARS];          // columns to move on after each character
+    unsigned short FirstRun[FONT_MAX_CHARS + 1];    // character c is Runs[FirstRun[c]] up to Runs[FirstRun[c+1]]
+    FontRun Runs[FONT_MAX_RUNS];
+} Font;
+
+// FontData.c
+extern const FontData Font5x7;
+extern const FontData Font5x7Proportional;
+
+// GraphicsFont.c
+int FontLoad(Font *font, const FontData *Data);
+int FontHeight(const Font *font, int Scale);
+int FontStringWidth(const Font *font, const char *String, int Scale);
+void DrawString(const Font *font, int x, int y, const char *String, int Scale, int Colour, int BackgroundColour);
+
+#endif
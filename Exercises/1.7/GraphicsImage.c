@@ -0,0 +1,66 @@
+/************************************************************************************************
+** Drawing run length coded images (see GraphicsImage.h)
+**
+** The image is drawn straight from its packets, without ever being unpacked into memory:
+**
+**  - each run is queued as one HLine however long it is (runs of the same colour one after the
+**    other are joined up first), so a splash screen made mostly of flat colour costs about one
+**    command per run. Runs of the transparent colour are just skipped
+**  - each literal is sent with BlitRect() straight from the packet's own bytes
+**
+** Both are cut to the clip rectangle (GraphicsClip.c) as usual. Rows above and below it are
+** stepped over without drawing anything
+***********************************************************************************************/
+
+#include "Graphics.h"
+#include "GraphicsImage.h"
+
+// Draw Image with its top left corner at x,y
+void DrawImage(const RLEImage *Image, int x, int y)
+{
+    const unsigned char *Packet = Image->Data;
+    int Row, Column, Length, Colour, Visible;
+    int SpanStart = 0, SpanColour = IMAGE_OPAQUE;       // run being joined up (none if IMAGE_OPAQUE)
+
+    for(Row = 0; Row < Image->Height; Row++) {
+        if (y + Row >= ClipBottom) {
+            return;
+        }
+        Visible = (y + Row >= ClipTop);
+
+        for(Column = 0; Column < Image->Width; Column += Length) {
+            if (*Packet < IMAGE_LITERAL) {
+                Length = *Packet - IMAGE_RUN + 1;
+                Colour = Packet[1];
+                Packet += 2;
+
+                // runs longer than IMAGE_MAX_RUN are coded as several runs but drawn as one HLine
+                if (Colour == SpanColour) {
+                    continue;
+                }
+                if (Visible && SpanColour != IMAGE_OPAQUE && SpanColour != Image->Transparent) {
+                    QueueSpan(x + SpanStart, x + Column, y + Row, SpanColour);
+                }
+                SpanStart = Column;
+                SpanColour = Colour;
+            }
+            else {
+                if (Visible && SpanColour != IMAGE_OPAQUE && SpanColour != Image->Transparent) {
+                    QueueSpan(x + SpanStart, x + Column, y + Row, SpanColour);
+                }
+                SpanColour = IMAGE_OPAQUE;
+
+                Length = *Packet - IMAGE_LITERAL + 1;
+                if (Visible) {
+                    BlitRect(x + Column, y + Row, Length, 1, Packet + 1, Length);
+                }
+                Packet += 1 + Length;
+            }
+        }
+
+        if (Visible && SpanColour != IMAGE_OPAQUE && SpanColour != Image->Transparent) {
+            QueueSpan(x + SpanStart, x + Image->Width, y + Row, SpanColour);
+        }
+        SpanColour = IMAGE_OPAQUE;
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef GRAPHICS_IMAGE_H
+#define GRAPHICS_IMAGE_H
+
+/************************************************************************************************
+** Run length coded images (GraphicsImage.c)
+**
+** An image is palette numbers, row by row from the top, each row coded as packets that cover
+** exactly Width pixels (a packet never carries on into the next row):
+**
+**      0x00 - 0x7F     a run: (byte + 1) pixels of the palette number in the next byte
+**      0x80 - 0xFF     literal: (byte - 0x7F) pixels whose palette numbers are the next bytes
+**
+** Pixels of the Transparent palette number are not drawn. They are only ever coded as runs, so
+** a literal never has to be looked through for them.
+** ImageConvert.c makes the C source for an image from a .ppm file on the host
+***********************************************************************************************/
+
+// Transparent for an image with no transparent pixels
+#define IMAGE_OPAQUE            -1
+
+// packet codes
+#define IMAGE_RUN               0x00
+#define IMAGE_LITERAL           0x80
+#define IMAGE_MAX_RUN           128
+#define IMAGE_MAX_LITERAL       128
+
+typedef struct {
+    int Width, Height;
+    int Transparent;                    // palette number that is not drawn, or IMAGE_OPAQUE
+    const unsigned char *Data;          // the packets
+} RLEImage;
+
+void DrawImage(const RLEImage *Image, int x, int y);
+
+#endif
@@ -0,0 +1,394 @@
+/************************************************************************************************
+** Host (Linux) software model of the graphics controller in GraphicsController_Verilog.v
+**
+** Lets the graphics driver in Graphics.c run on a workstation so drawing code can be tested and
+** timed without the DE1-SoC. Build the graphics test with e.g.
+**
+**      gcc -O2 -DGRAPHICS_HOST_MODEL -o GraphicsTest GraphicsTest.c Graphics.c GraphicsQueue.c \
+**          GraphicsPolygon.c GraphicsFont.c FontData.c GraphicsBlit.c GraphicsClip.c \
+**          GraphicsPalette.c GraphicsRaster.c GraphicsShadow.c GraphicsBackBuffer.c \
+**          GraphicsVSync.c GraphicsProfile.c GraphicsSprite.c GraphicsModel.c ColourPaletteData.c
+**
+** Each command is run state by state the same way as the Verilog state machine (see
+** GraphicsRaster.c) and every state is counted as one clock cycle, so GraphicsModelStatistics
+** gives the number of controller cycles the same drawing takes on the board
+***********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Graphics.h"
+
+extern const int ColourPaletteData[256];
+
+GraphicsModelRegisters GraphicsModelRegs;
+GraphicsModelStats GraphicsModelStatistics;
+
+// 256k x 16 bit frame buffer sram seen as 512 rows of 1024 pixels, only 480 x 800 of which are displayed
+static unsigned char Memory[GRAPHICS_MEMORY_ROWS][GRAPHICS_MEMORY_COLUMNS];
+static int Palette[GRAPHICS_MODEL_PALETTE_SIZE];
+
+static int Initialised = 0;
+static unsigned long long BusyUntil;        // clock at which the current command finishes
+static unsigned long long Cycles;           // clock cycles used by the command being run
+
+// state of a Blit command that is waiting for its pixels
+static int BlitActive = 0;
+static short int BlitX, BlitY, BlitX1, BlitX2, BlitY2;
+static int PixelDataWritten = 0;           // PixelData holds a pixel that has not been drawn yet
+
+static short int LastX2, LastY2;           // where the last Line or LineTo ended, i.e. where a LineTo starts
+
+static unsigned long long VSyncsAtClear;    // vertical syncs started when the CPU last wrote to VSyncClear
+
+// number of controller clocks from "Clock" until the LCD controller next drives VSync_L low
+static unsigned long long CyclesUntilVSync(unsigned long long Clock)
+{
+    unsigned long long FrameLength = (unsigned long long)GRAPHICS_MODEL_H_TOTAL * GRAPHICS_MODEL_V_TOTAL;
+    unsigned long long Pixel = Clock * GRAPHICS_MODEL_PIXEL_CLOCK_HZ / GRAPHICS_MODEL_CLOCK_HZ;
+    unsigned long long Position = Pixel % FrameLength;
+    unsigned long long SyncStart = (unsigned long long)GRAPHICS_MODEL_VSYNC_START * GRAPHICS_MODEL_H_TOTAL;
+    unsigned long long SyncEnd = SyncStart + (unsigned long long)GRAPHICS_MODEL_VSYNC_ROWS * GRAPHICS_MODEL_H_TOTAL;
+    unsigned long long Wait;
+
+    if (Position >= SyncStart && Position < SyncEnd) {
+        return 0;
+    }
+
+    Wait = (Position < SyncStart) ? SyncStart - Position : FrameLength - Position + SyncStart;
+    return (Wait * GRAPHICS_MODEL_CLOCK_HZ + GRAPHICS_MODEL_PIXEL_CLOCK_HZ - 1) / GRAPHICS_MODEL_PIXEL_CLOCK_HZ;
+}
+
+// number of vertical syncs the LCD controller has started by "Clock"
+static unsigned long long VSyncsStarted(unsigned long long Clock)
+{
+    unsigned long long FrameLength = (unsigned long long)GRAPHICS_MODEL_H_TOTAL * GRAPHICS_MODEL_V_TOTAL;
+    unsigned long long Pixel = Clock * GRAPHICS_MODEL_PIXEL_CLOCK_HZ / GRAPHICS_MODEL_CLOCK_HZ;
+    unsigned long long SyncStart = (unsigned long long)GRAPHICS_MODEL_VSYNC_START * GRAPHICS_MODEL_H_TOTAL;
+
+    return (Pixel + FrameLength - SyncStart) / FrameLength;
+}
+
+/*********************************************************************************************
+** The commands that do not draw anything. The drawing commands are run by GraphicsRaster.c
+*********************************************************************************************/
+
+static void RunGetPixel(void)
+{
+    Cycles += 3;                                            // ReadPixel, ReadPixel1, ReadPixel2
+    GraphicsModelRegs.ColourLatch = Memory[GraphicsModelRegs.Y1 & 0x1FF][GraphicsModelRegs.X1 & 0x3FF];
+}
+
+// LoadCoordinates, then DrawBlit waits for the CPU to write each pixel to PixelData
+static void RunBlit(void)
+{
+    Cycles++;                                               // LoadCoordinates
+    BlitX = BlitX1 = (short int)GraphicsModelRegs.X1;
+    BlitY = (short int)GraphicsModelRegs.Y1;
+    BlitX2 = (short int)GraphicsModelRegs.X2;
+    BlitY2 = (short int)GraphicsModelRegs.Y2;
+
+    if (BlitX1 >= BlitX2 || BlitY >= BlitY2)
+        Cycles++;                                           // DrawBlit, nothing to draw
+    else
+        BlitActive = 1;
+}
+
+// draw the pixel the CPU last wrote to PixelData at the next position of the Blit, the way the
+// DrawBlit state does once the CPU's write has finished
+static void DrawPixelData(void)
+{
+    if (!PixelDataWritten)
+        return;
+
+    // a pixel written when no Blit is running is never drawn: the next command write clears it
+    PixelDataWritten = 0;
+    if (!BlitActive)
+        return;
+
+    if (BlitX >= 0 && BlitX < WIDTH && BlitY >= 0 && BlitY < HEIGHT) {
+        Memory[BlitY & 0x1FF][BlitX & 0x3FF] = (unsigned char)(GraphicsModelRegs.PixelData & 0xFF);
+        GraphicsModelStatistics.PixelsWritten++;
+    }
+    GraphicsModelStatistics.CommandCycles[DrawBlit]++;
+
+    if (++BlitX >= BlitX2) {
+        BlitX = BlitX1;
+        BlitY++;
+    }
+
+    if (BlitY >= BlitY2) {
+        // DrawBlit sees the end of the rectangle on the next clock and goes back to Idle
+        BlitActive = 0;
+        BusyUntil = GraphicsModelStatistics.Clock + 2;
+        GraphicsModelStatistics.CommandCycles[DrawBlit] += 2;
+    }
+}
+
+// DrawCopy, then DrawCopyRead, DrawCopyRead1 and DrawCopyWrite for each pixel, starting from the
+// corner the rectangle is moving towards so that a copy onto itself reads each pixel before it is overwritten
+static void RunCopyRect(void)
+{
+    short int X1 = (short int)GraphicsModelRegs.X1, Y1 = (short int)GraphicsModelRegs.Y1;
+    short int X2 = (short int)GraphicsModelRegs.X2, Y2 = (short int)GraphicsModelRegs.Y2;
+    short int DestX = (short int)GraphicsModelRegs.DestX, DestY = (short int)GraphicsModelRegs.DestY;
+    int CopyLeft = (DestX > X1), CopyUp = (DestY > Y1);
+    short int X_line, Y_line, x, y;
+
+    Cycles++;                                               // DrawCopy
+    if (X1 >= X2 || Y1 >= Y2)
+        return;
+
+    X_line = CopyLeft ? X2 - 1 : X1;
+    Y_line = CopyUp ? Y2 - 1 : Y1;
+    for(;;) {
+        Cycles++;                                           // DrawCopyRead
+        if (Y_line < Y1 || Y_line >= Y2)
+            break;
+        Cycles += 2;                                        // DrawCopyRead1, DrawCopyWrite
+
+        x = X_line + (DestX - X1);
+        y = Y_line + (DestY - Y1);
+        if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT) {
+            Memory[y][x] = Memory[Y_line & 0x1FF][X_line & 0x3FF];
+            GraphicsModelStatistics.PixelsWritten++;
+        }
+
+        if (CopyLeft ? (X_line - 1 < X1) : (X_line + 1 >= X2)) {
+            X_line = CopyLeft ? X2 - 1 : X1;
+            Y_line += CopyUp ? -1 : 1;
+        }
+        else
+            X_line += CopyLeft ? -1 : 1;
+    }
+}
+
+static void RunProgramPallette(unsigned long long Start)
+{
+    // PalletteReProgram waits here until the display is in vertical sync
+    Cycles += CyclesUntilVSync(Start + Cycles) + 1;
+    Palette[GraphicsModelRegs.Colour & (GRAPHICS_MODEL_PALETTE_SIZE - 1)] =
+        ((GraphicsModelRegs.X1 & 0xFF) << 16) | GraphicsModelRegs.Y1;
+}
+
+// run the command the CPU last wrote to the command register (if any)
+static void RunPendingCommand(void)
+{
+    unsigned short int Command = GraphicsModelRegs.Command;
+    unsigned long long Start;
+
+    if (!Initialised)
+        GraphicsModelReset();
+
+    if (Command == 0)
+        return;
+
+    GraphicsModelRegs.Command = 0;
+
+    Start = (BusyUntil > GraphicsModelStatistics.Clock) ? BusyUntil : GraphicsModelStatistics.Clock;
+    Cycles = 2;                                             // Idle (sees command) + ProcessCommand
+
+    if (Command == GetAPixel)
+        RunGetPixel();
+    else if (Command == ProgramPaletteColour)
+        RunProgramPallette(Start);
+    else if (Command == DrawBlit)
+        RunBlit();
+    else if (Command == DrawCopyRect)
+        RunCopyRect();
+    else if (Command == DrawLineTo) {
+        Cycles += RasterCommand(Memory, DrawLine, LastX2, LastY2,
+            (short int)GraphicsModelRegs.X2, (short int)GraphicsModelRegs.Y2, GraphicsModelRegs.Colour,
+            &GraphicsModelStatistics.PixelsWritten);
+        LastX2 = (short int)GraphicsModelRegs.X2;
+        LastY2 = (short int)GraphicsModelRegs.Y2;
+    }
+    else {
+        if (Command == DrawLine) {
+            LastX2 = (short int)GraphicsModelRegs.X2;
+            LastY2 = (short int)GraphicsModelRegs.Y2;
+        }
+        Cycles += RasterCommand(Memory, Command, (short int)GraphicsModelRegs.X1, (short int)GraphicsModelRegs.Y1,
+            (short int)GraphicsModelRegs.X2, (short int)GraphicsModelRegs.Y2, GraphicsModelRegs.Colour,
+            &GraphicsModelStatistics.PixelsWritten);
+    }
+
+    // a Blit stays busy until its last pixel has been written
+    BusyUntil = BlitActive ? ~0ULL : Start + Cycles;
+
+    GraphicsModelStatistics.Commands++;
+    GraphicsModelStatistics.CommandCount[Command & 0xFF]++;
+    GraphicsModelStatistics.CommandCycles[Command & 0xFF] += Cycles;
+}
+
+/*********************************************************************************************
+** Put the model back into the state the Verilog reset leaves the controller in,
+** with a black screen and the palette from ColourPallette_2PortRam.mif
+*********************************************************************************************/
+
+void GraphicsModelReset(void)
+{
+    int i;
+
+    Initialised = 1;
+
+    memset(&GraphicsModelRegs, 0, sizeof(GraphicsModelRegs));
+    GraphicsModelRegs.X2 = 0x0400;
+    GraphicsModelRegs.Y2 = 0x0200;
+    GraphicsModelRegs.Colour = 0x4;
+
+    memset(Memory, 0, sizeof(Memory));
+    BlitActive = 0;
+    PixelDataWritten = 0;
+    LastX2 = LastY2 = 0;
+    VSyncsAtClear = 0;
+    for(i = 0; i < GRAPHICS_MODEL_PALETTE_SIZE; i++)
+        Palette[i] = ColourPaletteData[i];
+
+    BusyUntil = 0;
+    memset(&GraphicsModelStatistics, 0, sizeof(GraphicsModelStatistics));
+
+    // the driver (always linked with the model) has to write the registers again
+    GraphicsForgetRegisters();
+}
+
+/*********************************************************************************************
+** Called for every CPU read of the status register. Each read takes some controller clocks
+** so the controller reports busy (bit 0 = 0) until the command it is running would be finished.
+** The vertical sync bits follow the LCD timing from the same clock
+*********************************************************************************************/
+
+unsigned short int GraphicsModelReadStatus(void)
+{
+    unsigned short int Status = 0;
+
+    DrawPixelData();
+    RunPendingCommand();
+
+    GraphicsModelStatistics.StatusPolls++;
+    GraphicsModelStatistics.Clock += GRAPHICS_MODEL_CYCLES_PER_POLL;
+
+    if (CyclesUntilVSync(GraphicsModelStatistics.Clock) == 0)
+        Status |= GRAPHICS_STATUS_VSYNC;
+    if (VSyncsStarted(GraphicsModelStatistics.Clock) > VSyncsAtClear)
+        Status |= GRAPHICS_STATUS_VSYNC_SEEN;
+
+    if (GraphicsModelStatistics.Clock < BusyUntil) {
+        GraphicsModelStatistics.BusyPolls++;
+        return Status;
+    }
+    return Status | GRAPHICS_STATUS_IDLE;
+}
+
+// Called for every CPU write to the VSyncClear register, which clears the "vertical sync seen" status bit
+unsigned short int *GraphicsModelVSyncClear(void)
+{
+    if (!Initialised)
+        GraphicsModelReset();
+
+    GraphicsModelStatistics.Clock += GRAPHICS_MODEL_CYCLES_PER_POLL;
+    VSyncsAtClear = VSyncsStarted(GraphicsModelStatistics.Clock);
+    return &GraphicsModelRegs.VSyncClear;
+}
+
+/*********************************************************************************************
+** Called for every CPU write to the PixelData register. The pixel written last time is drawn
+** first (its write has finished by now) and the new value is stored through the pointer returned
+*********************************************************************************************/
+
+unsigned short int *GraphicsModelPixelData(void)
+{
+    RunPendingCommand();
+    DrawPixelData();
+
+    GraphicsModelStatistics.Clock += GRAPHICS_MODEL_CYCLES_PER_POLL;
+    PixelDataWritten = 1;
+    return &GraphicsModelRegs.PixelData;
+}
+
+// run any command still waiting and let the clock run on until the controller is idle
+void GraphicsModelFinish(void)
+{
+    DrawPixelData();
+    RunPendingCommand();
+
+    // a Blit still waiting for pixels would never finish
+    if (!BlitActive && GraphicsModelStatistics.Clock < BusyUntil)
+        GraphicsModelStatistics.Clock = BusyUntil;
+}
+
+// palette number of the displayed pixel at x,y (or -1 if x,y is not on screen)
+int GraphicsModelPixel(int x, int y)
+{
+    if (!Initialised)
+        GraphicsModelReset();
+
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+        return -1;
+
+    return Memory[y][x];
+}
+
+// clear the counters (but not the clock) e.g. between benchmark runs
+void GraphicsModelResetStats(void)
+{
+    unsigned long long Clock;
+
+    GraphicsModelFinish();
+    Clock = GraphicsModelStatistics.Clock;
+    memset(&GraphicsModelStatistics, 0, sizeof(GraphicsModelStatistics));
+    GraphicsModelStatistics.Clock = Clock;
+}
+
+void GraphicsModelPrintStats(void)
+{
+    int i;
+    double Seconds;
+
+    GraphicsModelFinish();
+    Seconds = (double)GraphicsModelStatistics.Clock / GRAPHICS_MODEL_CLOCK_HZ;
+
+    printf("Graphics model: %lu commands, %lu pixels, %llu cycles (%.3f ms at %d MHz)\n",
+        GraphicsModelStatistics.Commands, GraphicsModelStatistics.PixelsWritten,
+        GraphicsModelStatistics.Clock, Seconds * 1000.0, GRAPHICS_MODEL_CLOCK_HZ / 1000000);
+    printf("Graphics model: %lu status polls, %lu busy\n",
+        GraphicsModelStatistics.StatusPolls, GraphicsModelStatistics.BusyPolls);
+
+    for(i = 0; i < 256; i++) {
+        if (GraphicsModelStatistics.CommandCount[i] != 0) {
+            printf("    command 0x%02X: %lu run, %llu cycles\n", i,
+                GraphicsModelStatistics.CommandCount[i], GraphicsModelStatistics.CommandCycles[i]);
+        }
+    }
+}
+
+/*********************************************************************************************
+** Write what the LCD would be showing to a binary PPM image file
+** Returns 1 on success, 0 if the file could not be written
+*********************************************************************************************/
+
+int GraphicsModelSavePPM(const char *FileName)
+{
+    FILE *fp;
+    int x, y, RGB;
+
+    GraphicsModelFinish();
+
+    fp = fopen(FileName, "wb");
+    if (fp == NULL)
+        return 0;
+
+    fprintf(fp, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+    for(y = 0; y < HEIGHT; y++) {
+        for(x = 0; x < WIDTH; x++) {
+            // the video side uses the low 6 bits of each pixel to look up the palette
+            RGB = Palette[Memory[y][x] & (GRAPHICS_MODEL_PALETTE_SIZE - 1)];
+            fputc((RGB >> 16) & 0xFF, fp);
+            fputc((RGB >> 8) & 0xFF, fp);
+            fputc(RGB & 0xFF, fp);
+        }
+    }
+
+    fclose(fp);
+    return 1;
+}
@@ -0,0 +1,77 @@
+#ifndef GRAPHICS_MODEL_H
+#define GRAPHICS_MODEL_H
+
+/************************************************************************************************
+** Host (Linux) software model of GraphicsController_Verilog.v
+**
+** Graphics.h maps the graphics registers onto the structure below when GRAPHICS_HOST_MODEL is
+** defined. A write to the command register is picked up the next time the CPU reads the status
+** register, at which point the model runs the command the same way the state machine would and
+** counts how many controller clock cycles it takes. Writes to the PixelData register go through
+** GraphicsModelPixelData() so the pixels of a Blit command are drawn as they arrive, and writes to
+** VSyncClear through GraphicsModelVSyncClear()
+***********************************************************************************************/
+
+// controller and LCD timing used to turn cycles into time (see GraphicsLCD_Controller_verilog.v)
+#define GRAPHICS_MODEL_CLOCK_HZ         50000000        // graphics controller clock
+#define GRAPHICS_MODEL_PIXEL_CLOCK_HZ   30000000        // LCD pixel clock (800x480 @60HZ)
+#define GRAPHICS_MODEL_H_TOTAL          993             // B+C+D+E+1 pixel clocks per row
+#define GRAPHICS_MODEL_V_TOTAL          503             // P+Q+R+S+1 rows per frame
+#define GRAPHICS_MODEL_VSYNC_START      483             // VSync_L goes low at row R+S
+#define GRAPHICS_MODEL_VSYNC_ROWS       7               // and stays low for P rows
+
+// approximate number of controller clocks a status read (or PixelData write) across the lightweight bridge takes
+#define GRAPHICS_MODEL_CYCLES_PER_POLL  8
+
+// the palette ram only has 6 address bits so only 64 of the 256 palette numbers are distinct
+#define GRAPHICS_MODEL_PALETTE_SIZE     64
+
+typedef struct {
+    unsigned short int Command;             // 0 when no command is waiting to be run
+    unsigned short int X1, Y1, X2, Y2;
+    unsigned short int Colour;
+    unsigned short int ColourLatch;         // what a CPU read of the colour register returns
+    unsigned short int BackGroundColour;
+    unsigned short int PixelData;
+    unsigned short int VSyncClear;
+    unsigned short int DestX, DestY;
+} GraphicsModelRegisters;
+
+typedef struct {
+    unsigned long long Clock;                   // controller clock cycles elapsed
+    unsigned long Commands;                     // total commands run
+    unsigned long CommandCount[256];            // commands run, by command number
+    unsigned long long CommandCycles[256];      // clock cycles spent, by command number
+    unsigned long PixelsWritten;                // frame buffer writes
+    unsigned long StatusPolls;                  // CPU reads of the status register
+    unsigned long BusyPolls;                    // ... that found the controller busy
+} GraphicsModelStats;
+
+extern GraphicsModelRegisters GraphicsModelRegs;
+extern GraphicsModelStats GraphicsModelStatistics;
+
+#define GraphicsCommandReg   		(GraphicsModelRegs.Command)
+#define GraphicsStatusReg   		(GraphicsModelReadStatus())
+#define GraphicsX1Reg   			(GraphicsModelRegs.X1)
+#define GraphicsY1Reg   			(GraphicsModelRegs.Y1)
+#define GraphicsX2Reg   			(GraphicsModelRegs.X2)
+#define GraphicsY2Reg   			(GraphicsModelRegs.Y2)
+#define GraphicsColourReg   		(GraphicsModelRegs.Colour)
+#define GraphicsColourLatchReg   	(GraphicsModelRegs.ColourLatch)
+#define GraphicsBackGroundColourReg   	(GraphicsModelRegs.BackGroundColour)
+#define GraphicsPixelDataReg   		(*GraphicsModelPixelData())
+#define GraphicsVSyncClearReg   		(*GraphicsModelVSyncClear())
+#define GraphicsDestXReg   			(GraphicsModelRegs.DestX)
+#define GraphicsDestYReg   			(GraphicsModelRegs.DestY)
+
+void GraphicsModelReset(void);
+unsigned short int GraphicsModelReadStatus(void);
+unsigned short int *GraphicsModelPixelData(void);
+unsigned short int *GraphicsModelVSyncClear(void);
+void GraphicsModelFinish(void);
+int GraphicsModelPixel(int x, int y);
+void GraphicsModelResetStats(void);
+void GraphicsModelPrintStats(void);
+int GraphicsModelSavePPM(const char *FileName);
+
+#endif
@@ -0,0 +1,143 @@
+/************************************************************************************************
+** Loading and animating the colour palette
+**
+** The graphics chip's palette can only be written one entry per ProgramPaletteColour command,
+** and each command waits for the display to be in vertical sync. ProgramPaletteRange() queues
+** the entries that actually change one after the other, so the graphics chip programs them all
+** during the same vertical sync instead of the CPU waiting for each one.
+**
+** The palette cannot be read back, so a copy of what has been programmed is kept here (starting
+** with the colours in ColourPallette_2PortRam.mif). Colour cycling uses it to rotate a range of
+** entries one place each time CyclePalettes() is called, e.g. once per frame, which animates
+** anything drawn in those colours without drawing any pixels.
+**
+** Only PALETTE_SIZE (64) entries exist in the hardware: palette number n uses entry n % 64
+***********************************************************************************************/
+
+#include "Graphics.h"
+
+extern const int ColourPaletteData[256];
+
+typedef struct {
+    int First;              // entries First up to First+Count-1 are rotated
+    int Count;
+    int Direction;          // +1 moves each colour to the next entry, -1 to the one before
+} PaletteCycle;
+
+static int PaletteColours[PALETTE_SIZE];
+static int PaletteInitialised = 0;
+
+static PaletteCycle Cycles[PALETTE_MAX_CYCLES];
+
+static void PaletteInit(void)
+{
+    int i;
+
+    for(i = 0; i < PALETTE_SIZE; i++) {
+        PaletteColours[i] = ColourPaletteData[i];
+    }
+    PaletteInitialised = 1;
+}
+
+// The RGB value palette number PaletteNumber was last programmed with
+int ReadPaletteColour(int PaletteNumber)
+{
+    if (!PaletteInitialised) {
+        PaletteInit();
+    }
+    return PaletteColours[PaletteNumber & (PALETTE_SIZE - 1)];
+}
+
+// Called by ProgramPalette() and QueueProgramPalette() to keep the copy of the palette up to date
+void RememberPaletteColour(int PaletteNumber, int RGB)
+{
+    if (!PaletteInitialised) {
+        PaletteInit();
+    }
+    PaletteColours[PaletteNumber & (PALETTE_SIZE - 1)] = RGB;
+}
+
+/*********************************************************************************************
+** Program palette numbers First up to First+Count-1 with RGB[0] to RGB[Count-1].
+** Entries that already have the right colour are left alone and the rest are queued, so this
+** returns straight away and they all change during the next vertical sync
+*********************************************************************************************/
+
+void ProgramPaletteRange(int First, int Count, const int *RGB)
+{
+    int i;
+
+    if (First < 0) {
+        RGB -= First;
+        Count += First;
+        First = 0;
+    }
+    if (First + Count > PALETTE_SIZE) {
+        Count = PALETTE_SIZE - First;
+    }
+
+    for(i = 0; i < Count; i++) {
+        if (ReadPaletteColour(First + i) != RGB[i]) {
+            QueueProgramPalette(First + i, RGB[i]);
+        }
+    }
+}
+
+// Program the whole palette from a table of PALETTE_SIZE RGB values
+void ProgramWholePalette(const int *RGB)
+{
+    ProgramPaletteRange(0, PALETTE_SIZE, RGB);
+}
+
+/*********************************************************************************************
+** Rotate palette numbers First up to First+Count-1 one place (Direction +1 or -1) every time
+** CyclePalettes() is called. Returns a number for RemovePaletteCycle(), or -1 if there are
+** already PALETTE_MAX_CYCLES ranges being rotated
+*********************************************************************************************/
+
+int AddPaletteCycle(int First, int Count, int Direction)
+{
+    int i;
+
+    if (First < 0 || Count < 2 || First + Count > PALETTE_SIZE) {
+        return -1;
+    }
+
+    for(i = 0; i < PALETTE_MAX_CYCLES; i++) {
+        if (Cycles[i].Count == 0) {
+            Cycles[i].First = First;
+            Cycles[i].Count = Count;
+            Cycles[i].Direction = (Direction < 0) ? -1 : 1;
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Stop rotating a range. Its colours stay where they are
+void RemovePaletteCycle(int Cycle)
+{
+    if (Cycle >= 0 && Cycle < PALETTE_MAX_CYCLES) {
+        Cycles[Cycle].Count = 0;
+    }
+}
+
+// Rotate every range added with AddPaletteCycle() one place. Call once per frame
+void CyclePalettes(void)
+{
+    int Rotated[PALETTE_SIZE];
+    int i, j;
+    PaletteCycle *Cycle;
+
+    for(i = 0; i < PALETTE_MAX_CYCLES; i++) {
+        Cycle = &Cycles[i];
+        if (Cycle->Count == 0) {
+            continue;
+        }
+
+        for(j = 0; j < Cycle->Count; j++) {
+            Rotated[(j + Cycle->Direction + Cycle->Count) % Cycle->Count] = ReadPaletteColour(Cycle->First + j);
+        }
+        ProgramPaletteRange(Cycle->First, Cycle->Count, Rotated);
+    }
+}
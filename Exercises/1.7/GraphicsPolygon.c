@@ -0,0 +1,217 @@
+/************************************************************************************************
+** Filled triangles and convex polygons, and polylines and polygon outlines
+**
+** The polygon is filled one row at a time by walking its left and right edges and queuing one
+** HLine per row. A pixel is filled when its centre is inside the polygon, or on a left or top
+** edge, so two polygons that share an edge never draw the same pixel twice and nothing is left
+** between them. Like the graphics chip's own lines, the right and bottom edges are "stopping
+** points", e.g. the triangle (0,0) (10,0) (0,10) does not fill row 10 or column 10
+**
+** Edges are walked with integer steps only (no division per row) because the Cortex-A9 has
+** no divide instruction
+**
+** A polyline is drawn with the graphics chip's LineTo command, which starts each line where the
+** last one ended, so every segment after the first costs 3 register writes (X2, Y2 and the
+** command) instead of the 6 of a Line()
+***********************************************************************************************/
+
+#include "Graphics.h"
+
+typedef struct {
+    int Column;             // first pixel whose centre is to the right of the edge on this row
+    int Remainder;          // fraction of a pixel the edge is past Column, scaled by Denominator
+    int StepColumn;         // whole pixels the edge moves each row
+    int StepRemainder;      // and the fraction
+    int Denominator;
+    int EndRow;             // the edge finishes before this row
+} PolygonEdge;
+
+// a/b rounded down, for b > 0
+static long long FloorDiv(long long a, long long b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+/*********************************************************************************************
+** Set up an edge from (xa,ya) to (xb,yb), where ya < yb, ready to give the column for "row".
+** The edge crosses the centre line of a row at x = xa + (row + 0.5 - ya) * dx / dy and the first
+** pixel filled to the right of it is the one whose centre is on or after that point
+*********************************************************************************************/
+
+static void EdgeStart(PolygonEdge *Edge, int xa, int ya, int xb, int yb, int row)
+{
+    long long dx = xb - xa;
+    long long dy = yb - ya;
+    long long Numerator = (2 * (long long)(row - ya) + 1) * dx - dy;
+    long long Step;
+
+    Edge->Denominator = (int)(2 * dy);
+    Edge->Column = xa - (int)FloorDiv(-Numerator, Edge->Denominator);      // xa + ceil(N/D)
+    Edge->Remainder = (int)(Numerator - (long long)(Edge->Column - xa) * Edge->Denominator);
+
+    Step = FloorDiv(2 * dx, Edge->Denominator);
+    Edge->StepColumn = (int)Step;
+    Edge->StepRemainder = (int)(2 * dx - Step * Edge->Denominator);
+    Edge->EndRow = yb;
+}
+
+static void EdgeStep(PolygonEdge *Edge)
+{
+    Edge->Column += Edge->StepColumn;
+    Edge->Remainder += Edge->StepRemainder;
+    if (Edge->Remainder > 0) {
+        Edge->Column++;
+        Edge->Remainder -= Edge->Denominator;
+    }
+}
+
+/*********************************************************************************************
+** Move along one side of the polygon (Direction = +1 or -1 through the points) until we reach
+** an edge that covers "row". Returns 0 if we run out of points first
+*********************************************************************************************/
+
+static int EdgeFind(PolygonEdge *Edge, int *Point, int Direction, const int *x, const int *y,
+    int NumPoints, int row)
+{
+    int Next, Steps = 0;
+
+    while (Edge->EndRow <= row) {
+        if (++Steps > NumPoints) {
+            return 0;
+        }
+        Next = (*Point + Direction + NumPoints) % NumPoints;
+        if (y[Next] > row && y[*Point] <= row) {
+            EdgeStart(Edge, x[*Point], y[*Point], x[Next], y[Next], row);
+        }
+        *Point = Next;
+    }
+    return 1;
+}
+
+/*********************************************************************************************
+** Fill a convex polygon with NumPoints corners at (x[i],y[i]). The points can go round either
+** way. Non convex polygons are not filled correctly
+*********************************************************************************************/
+
+void FilledPolygon(const int *x, const int *y, int NumPoints, int Colour)
+{
+    PolygonEdge Left, Right;
+    int LeftPoint, RightPoint;
+    int Top = 0, Bottom, row, i;
+
+    if (NumPoints < 3) {
+        return;
+    }
+
+    Bottom = y[0];
+    for(i = 1; i < NumPoints; i++) {
+        if (y[i] < y[Top]) {
+            Top = i;
+        }
+        if (y[i] > Bottom) {
+            Bottom = y[i];
+        }
+    }
+
+    // nothing above the top of the screen or from the bottom of the screen down is drawn
+    row = (y[Top] < 0) ? 0 : y[Top];
+    if (Bottom > HEIGHT) {
+        Bottom = HEIGHT;
+    }
+
+    LeftPoint = RightPoint = Top;
+    Left.EndRow = Right.EndRow = row;           // find the first edges below
+
+    for(; row < Bottom; row++) {
+        if (!EdgeFind(&Left, &LeftPoint, 1, x, y, NumPoints, row) ||
+            !EdgeFind(&Right, &RightPoint, -1, x, y, NumPoints, row)) {
+            return;
+        }
+
+        if (Left.Column < Right.Column) {
+            QueueSpan(Left.Column, Right.Column, row, Colour);
+        } else {
+            QueueSpan(Right.Column, Left.Column, row, Colour);
+        }
+
+        EdgeStep(&Left);
+        EdgeStep(&Right);
+    }
+}
+
+// Draw a triangle filled with colour Colour with corners at (x1,y1), (x2,y2), and (x3, y3)
+void FilledTriangle(int x1, int y1, int x2, int y2, int x3, int y3, int Colour)
+{
+    int x[3], y[3];
+
+    x[0] = x1; y[0] = y1;
+    x[1] = x2; y[1] = y2;
+    x[2] = x3; y[2] = y3;
+
+    FilledPolygon(x, y, 3, Colour);
+}
+
+/*********************************************************************************************
+** Draw lines of colour Colour joining the NumPoints points (x[i],y[i]) in turn. Each segment
+** draws the same pixels as Line() would, so the last point itself is not drawn.
+** A segment that has to be clipped by the driver is drawn with ClippedLine() and the one after
+** it starts again with a whole Line command
+*********************************************************************************************/
+
+void Polyline(const int *x, const int *y, int NumPoints, int Colour)
+{
+    int i, Clip, Chained = 0;
+
+    // drawing into the back buffer costs nothing on the graphics chip
+    if (GraphicsBackBufferActive) {
+        for(i = 1; i < NumPoints; i++) {
+            Line(x[i - 1], y[i - 1], x[i], y[i], Colour);
+        }
+        return;
+    }
+
+    for(i = 1; i < NumPoints; i++) {
+        Clip = ClipLine(x[i - 1], y[i - 1], x[i], y[i]);
+
+        if (Clip == CLIP_REJECT) {
+            Chained = 0;
+            continue;
+        }
+        if (Clip == CLIP_PARTIAL) {
+            ClippedLine(x[i - 1], y[i - 1], x[i], y[i], Colour);
+            Chained = 0;
+            continue;
+        }
+
+        WAIT_FOR_GRAPHICS;
+
+        if (Chained) {
+            GRAPHICS_WRITE(X2, x[i]);           // the graphics chip starts where the last line ended
+            GRAPHICS_WRITE(Y2, y[i]);
+            GraphicsCommandReg = DrawLineTo;
+            PROFILE_COMMAND(DrawLineTo, 3);
+        }
+        else {
+            GRAPHICS_WRITE(X1, x[i - 1]);
+            GRAPHICS_WRITE(Y1, y[i - 1]);
+            GRAPHICS_WRITE(X2, x[i]);
+            GRAPHICS_WRITE(Y2, y[i]);
+            GRAPHICS_WRITE(Colour, Colour);
+            GraphicsCommandReg = DrawLine;
+            PROFILE_COMMAND(DrawLine, 6);
+            Chained = 1;
+        }
+        SHADOW_COMMAND(DrawLine, x[i - 1], y[i - 1], x[i], y[i], Colour);
+    }
+}
+
+// Draw the outline of a polygon with NumPoints corners at (x[i],y[i]) in colour Colour, i.e. a
+// polyline that goes back to the first point
+void PolygonOutline(const int *x, const int *y, int NumPoints, int Colour)
+{
+    if (NumPoints < 2) {
+        return;
+    }
+    Polyline(x, y, NumPoints, Colour);
+    Line(x[NumPoints - 1], y[NumPoints - 1], x[0], y[0], Colour);
+}
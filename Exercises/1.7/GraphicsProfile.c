@@ -0,0 +1,198 @@
+/************************************************************************************************
+** Graphics profiler
+**
+** Build everything with -DGRAPHICS_PROFILE to count, for each kind of command sent to the
+** graphics chip (HLine, VLine, Line, Circle, PutAPixel, ProgramPalette etc):
+**
+**  - how many were sent and how many register writes that took, not counting the writes that
+**    GRAPHICS_WRITE left out because the register already held the value
+**  - how many times the CPU went round a loop waiting for the graphics chip to finish them
+**  - the time from sending each one until the next command is sent. When the CPU is drawing
+**    faster than the graphics chip this is how long the graphics chip took to draw it
+**
+** Commands are counted as they are written to the graphics chip, so a queued command is
+** counted when it leaves the queue and shapes cut away completely by clipping are not counted.
+** GraphicsProfilePrint() prints the counts as a table through putchar, putcharRS232 etc.
+**
+** Without -DGRAPHICS_PROFILE the PROFILE_ macros in Graphics.h are empty, so the driver runs
+** exactly as fast as it did before, and GraphicsProfilePrint() just says so
+***********************************************************************************************/
+
+#include <stdio.h>
+
+#include "Graphics.h"
+
+#ifdef GRAPHICS_PROFILE
+
+#ifdef GRAPHICS_HOST_MODEL
+
+// on the host time is the model's graphics controller clock
+#define PROFILE_TICKS_PER_SECOND    GRAPHICS_MODEL_CLOCK_HZ
+
+static void StartProfileTimer(void)
+{
+}
+
+static unsigned int ReadProfileTimer(void)
+{
+    return (unsigned int)GraphicsModelStatistics.Clock;
+}
+
+#else
+
+// Cortex-A9 global timer, clocked at 200MHz. It is free running so it does not disturb
+// anything using the private timer (e.g. GraphicsBenchmark.c)
+#define GlobalTimerCounterLow       (*(volatile unsigned int *)(0xFFFEC200))
+#define GlobalTimerControl          (*(volatile unsigned int *)(0xFFFEC208))
+
+#define PROFILE_TICKS_PER_SECOND    200000000
+
+static void StartProfileTimer(void)
+{
+    GlobalTimerControl |= 1;                // enable
+}
+
+// wraps after about 21 seconds but only differences are used
+static unsigned int ReadProfileTimer(void)
+{
+    return GlobalTimerCounterLow;
+}
+
+#endif
+
+GraphicsProfileEntry GraphicsProfile[GRAPHICS_PROFILE_COMMANDS];
+int GraphicsProfileLast = 0;                // the command sent last (0 before the first one)
+
+static unsigned int LastTime;               // time the last command was sent
+static unsigned long LastElidedWrites;      // GraphicsElidedWrites when the last command was sent
+static unsigned long ResetElidedWrites;     // and at the last GraphicsProfileReset()
+static int ProfileStarted = 0;
+
+// Called (through PROFILE_COMMAND) every time a command is written to the graphics chip
+void GraphicsProfileCommand(int Command, int Writes)
+{
+    unsigned int Now;
+    GraphicsProfileEntry *Entry;
+
+    if (!ProfileStarted) {
+        GraphicsProfileReset();
+    }
+
+    Now = ReadProfileTimer();
+    GraphicsProfile[GraphicsProfileLast].Ticks += Now - LastTime;
+    LastTime = Now;
+
+    Command &= GRAPHICS_PROFILE_COMMANDS - 1;
+    Entry = &GraphicsProfile[Command];
+    Entry->Commands++;
+    Entry->Writes += Writes - (GraphicsElidedWrites - LastElidedWrites);
+    LastElidedWrites = GraphicsElidedWrites;
+    GraphicsProfileLast = Command;
+}
+
+// Clear the counts and start timing again
+void GraphicsProfileReset(void)
+{
+    int i;
+
+    StartProfileTimer();
+    for(i = 0; i < GRAPHICS_PROFILE_COMMANDS; i++) {
+        GraphicsProfile[i].Commands = 0;
+        GraphicsProfile[i].Writes = 0;
+        GraphicsProfile[i].Waits = 0;
+        GraphicsProfile[i].Ticks = 0;
+    }
+    GraphicsProfileLast = 0;
+    LastTime = ReadProfileTimer();
+    LastElidedWrites = GraphicsElidedWrites;
+    ResetElidedWrites = GraphicsElidedWrites;
+    ProfileStarted = 1;
+}
+
+static const char *CommandName(int Command)
+{
+    switch (Command) {
+        case 0:                     return "(none)";
+        case DrawHLine:             return "HLine";
+        case DrawVLine:             return "VLine";
+        case DrawLine:              return "Line";
+        case PutAPixel:             return "PutAPixel";
+        case GetAPixel:             return "GetAPixel";
+        case ProgramPaletteColour:  return "ProgramPalette";
+        case DrawCircle:            return "Circle";
+        case DrawFilledRect:        return "FilledRect";
+        case DrawBlit:              return "Blit";
+        case DrawLineTo:            return "LineTo";
+        case DrawEllipse:           return "Ellipse";
+        case DrawArc:               return "Arc";
+        case DrawCopyRect:          return "CopyRect";
+        default:                    return "?";
+    }
+}
+
+static void PrintString(int (*PutChar)(int), const char *String)
+{
+    while (*String != '\0') {
+        PutChar(*String++);
+    }
+}
+
+/*********************************************************************************************
+** Print a table of the counts since the last GraphicsProfileReset() (or the first command),
+** one line per kind of command sent, e.g. GraphicsProfilePrint(putchar).
+** The time up to now is counted against the last command sent
+*********************************************************************************************/
+
+void GraphicsProfilePrint(int (*PutChar)(int))
+{
+    char Line[128];
+    int i;
+    unsigned int Now;
+    unsigned long long Total = 0;
+
+    if (!ProfileStarted) {
+        GraphicsProfileReset();
+    }
+
+    Now = ReadProfileTimer();
+    GraphicsProfile[GraphicsProfileLast].Ticks += Now - LastTime;
+    LastTime = Now;
+
+    for(i = 0; i < GRAPHICS_PROFILE_COMMANDS; i++) {
+        Total += GraphicsProfile[i].Ticks;
+    }
+
+    sprintf(Line, "%-16s %10s %10s %10s %12s %6s\n", "command", "sent", "writes", "waits", "us", "%time");
+    PrintString(PutChar, Line);
+
+    for(i = 0; i < GRAPHICS_PROFILE_COMMANDS; i++) {
+        if (GraphicsProfile[i].Commands == 0 && GraphicsProfile[i].Ticks == 0) {
+            continue;
+        }
+        sprintf(Line, "%-16s %10lu %10lu %10lu %12.0f %6.1f\n", CommandName(i),
+            GraphicsProfile[i].Commands, GraphicsProfile[i].Writes, GraphicsProfile[i].Waits,
+            GraphicsProfile[i].Ticks * 1000000.0 / PROFILE_TICKS_PER_SECOND,
+            (Total == 0) ? 0.0 : GraphicsProfile[i].Ticks * 100.0 / Total);
+        PrintString(PutChar, Line);
+    }
+
+    sprintf(Line, "register writes left out as unchanged: %lu\n", GraphicsElidedWrites - ResetElidedWrites);
+    PrintString(PutChar, Line);
+}
+
+#else
+
+void GraphicsProfileReset(void)
+{
+}
+
+void GraphicsProfilePrint(int (*PutChar)(int))
+{
+    const char *String = "Graphics profiling not compiled in (build with -DGRAPHICS_PROFILE)\n";
+
+    while (*String != '\0') {
+        PutChar(*String++);
+    }
+}
+
+#endif
@@ -0,0 +1,267 @@
+/************************************************************************************************
+** Graphics command queue
+**
+** Instead of waiting for the graphics chip before every shape, the Queue functions record the
+** shape in a preallocated ring and return straight away. Queued commands are written to the
+** graphics chip whenever it is found to be idle, i.e. every time something is queued and every
+** time GraphicsQueueService() is called, so the CPU can get on with working out the next shape
+** while the graphics chip is still drawing the last one.
+**
+** WAIT_FOR_GRAPHICS flushes the queue first so the immediate functions in Graphics.c
+** (HLine, ReadAPixel etc) can still be mixed with queued ones and are done in order
+**
+** Every Queue function returns a fence: a number that GraphicsFenceReached() says has been
+** reached once everything queued up to and including that call has been drawn, and that
+** GraphicsWait() waits for. Fences are just counts of the commands queued, so a later fence is
+** always reached after an earlier one. QueueReadPixel() reads a pixel the same way, so the CPU
+** only waits for the shapes queued before it, and only when it needs the answer
+***********************************************************************************************/
+
+#include <stddef.h>
+
+#include "Graphics.h"
+
+typedef struct {
+    unsigned short int Command;
+    unsigned short int X1, Y1, X2, Y2;
+    unsigned short int Colour;
+    int *Result;                            // where a GetAPixel puts the pixel it read
+} GraphicsQueueEntry;
+
+static GraphicsQueueEntry Queue[GRAPHICS_QUEUE_SIZE];
+static unsigned int QueueHead = 0;          // next entry to send to the graphics chip
+static unsigned int QueueTail = 0;          // next free entry
+static unsigned int QueueDone = 0;          // entries before this one have been drawn
+
+// the GetAPixel sent last, if its pixel has not been read from the colour latch yet
+static int *PendingResult = NULL;
+
+// Called when the graphics chip has been seen to be idle: everything sent to it so far is done
+static void QueueFinished(void)
+{
+    if (PendingResult != NULL) {
+        *PendingResult = (int)GraphicsColourLatchReg;
+        PendingResult = NULL;
+    }
+    QueueDone = QueueHead;
+}
+
+/*********************************************************************************************
+** Write as many queued commands to the graphics chip as it will take without waiting, i.e.
+** send the next one each time the status register says it is idle.
+** Returns the number of commands still in the queue
+*********************************************************************************************/
+
+int GraphicsQueueService(void)
+{
+    GraphicsQueueEntry *Entry;
+
+    while (QueueHead != QueueTail && (GraphicsStatusReg & 0x0001) == 0x0001) {
+        QueueFinished();
+        Entry = &Queue[QueueHead % GRAPHICS_QUEUE_SIZE];
+
+        GRAPHICS_WRITE(X1, Entry->X1);
+        GRAPHICS_WRITE(Y1, Entry->Y1);
+        GRAPHICS_WRITE(X2, Entry->X2);
+        GRAPHICS_WRITE(Y2, Entry->Y2);
+        GRAPHICS_WRITE(Colour, Entry->Colour);
+        GraphicsCommandReg = Entry->Command;
+        PROFILE_COMMAND(Entry->Command, 6);
+
+        if (Entry->Command == GetAPixel) {
+            PendingResult = Entry->Result;
+        }
+        QueueHead++;
+    }
+
+    return (int)(QueueTail - QueueHead);
+}
+
+// Send everything in the queue to the graphics chip. The last command may still be drawing
+// when this returns, unless it is a GetAPixel: that is waited for so its pixel is read before
+// the caller sends anything else
+void GraphicsQueueFlush(void)
+{
+    while (QueueHead != QueueTail) {
+        if (GraphicsQueueService() != 0) {
+            PROFILE_WAIT;
+        }
+    }
+    if (PendingResult != NULL) {
+        while ((GraphicsStatusReg & 0x0001) != 0x0001) {
+            PROFILE_WAIT;
+        }
+        QueueFinished();
+    }
+}
+
+int GraphicsQueueCount(void)
+{
+    return (int)(QueueTail - QueueHead);
+}
+
+// The fence for everything queued so far
+unsigned int GraphicsQueueFence(void)
+{
+    return QueueTail;
+}
+
+/*********************************************************************************************
+** Returns 1 if everything queued up to Fence has been drawn (and any pixels read), without
+** waiting. Sends the graphics chip more of the queue if it is idle, so calling this in a loop
+** keeps it busy
+*********************************************************************************************/
+
+int GraphicsFenceReached(unsigned int Fence)
+{
+    GraphicsQueueService();
+
+    if ((int)(Fence - QueueDone) <= 0) {
+        return 1;
+    }
+    if ((int)(QueueHead - Fence) >= 0 && (GraphicsStatusReg & 0x0001) == 0x0001) {
+        QueueFinished();
+        return 1;
+    }
+    return 0;
+}
+
+// Wait until everything queued up to Fence has been drawn. Anything queued after it is left in
+// the queue if the graphics chip gets to Fence first
+void GraphicsWait(unsigned int Fence)
+{
+    while (!GraphicsFenceReached(Fence)) {
+        PROFILE_WAIT;
+    }
+}
+
+// Add a command to the queue, making room first if the queue is full
+static void QueueCommand(int Command, int x1, int y1, int x2, int y2, int Colour, int *Result)
+{
+    GraphicsQueueEntry *Entry;
+
+    if (Command != ProgramPaletteColour) {
+        BACK_BUFFER_COMMAND(Command, x1, y1, x2, y2, Colour);
+    }
+
+    while (QueueTail - QueueHead >= GRAPHICS_QUEUE_SIZE) {
+        if (GraphicsQueueService() >= GRAPHICS_QUEUE_SIZE) {
+            PROFILE_WAIT;
+        }
+    }
+
+    Entry = &Queue[QueueTail % GRAPHICS_QUEUE_SIZE];
+    Entry->Command = Command;
+    Entry->X1 = x1;
+    Entry->Y1 = y1;
+    Entry->X2 = x2;
+    Entry->Y2 = y2;
+    Entry->Colour = Colour;
+    Entry->Result = Result;
+    QueueTail++;
+
+    SHADOW_COMMAND(Command, x1, y1, x2, y2, Colour);
+    GraphicsQueueService();             // start it now if the graphics chip is idle
+}
+
+/*********************************************************************************************
+** Queued versions of the shapes in Graphics.c. They take the same arguments and draw exactly
+** the same thing but do not wait for the graphics chip. Each returns the fence for the shape
+*********************************************************************************************/
+
+unsigned int QueueWritePixel(int x, int y, int Colour)
+{
+    if (!ClipPixel(x, y)) {
+        return QueueTail;
+    }
+    QueueCommand(PutAPixel, x, y, 0, 0, Colour, NULL);
+    return QueueTail;
+}
+
+unsigned int QueueProgramPalette(int PaletteNumber, int RGB)
+{
+    QueueCommand(ProgramPaletteColour, RGB >> 16, RGB, 0, 0, PaletteNumber, NULL);
+    RememberPaletteColour(PaletteNumber, RGB);
+    return QueueTail;
+}
+
+unsigned int QueueHLine(int x1, int y1, int length, int Colour)
+{
+    return QueueSpan(x1, x1 + length, y1, Colour);
+}
+
+unsigned int QueueVLine(int x1, int y1, int length, int Colour)
+{
+    int y2 = y1 + length;
+
+    if (ClipVSpan(x1, &y1, &y2)) {
+        QueueCommand(DrawVLine, x1, y1, x1, y2, Colour, NULL);
+    }
+    return QueueTail;
+}
+
+unsigned int QueueLine(int x1, int y1, int x2, int y2, int Colour)
+{
+    int Clip = ClipLine(x1, y1, x2, y2);
+
+    if (Clip == CLIP_ACCEPT) {
+        QueueCommand(DrawLine, x1, y1, x2, y2, Colour, NULL);
+    }
+    else if (Clip == CLIP_PARTIAL) {
+        ClippedLine(x1, y1, x2, y2, Colour);
+    }
+    return QueueTail;
+}
+
+unsigned int QueueCircle(int centreX, int centreY, int radius, int Colour)
+{
+    int Clip = ClipCircle(centreX, centreY, radius);
+
+    if (Clip == CLIP_ACCEPT) {
+        QueueCommand(DrawCircle, centreX, centreY, radius, 0, Colour, NULL);
+    }
+    else if (Clip == CLIP_PARTIAL) {
+        ClippedCircle(centreX, centreY, radius, Colour);
+    }
+    return QueueTail;
+}
+
+unsigned int QueueFilledRectangle(int x1, int y1, int width, int height, int Colour)
+{
+    int x2 = x1 + width;
+    int y2 = y1 + height;
+
+    if (ClipBox(&x1, &y1, &x2, &y2)) {
+        QueueCommand(DrawFilledRect, x1, y1, x2, y2, Colour, NULL);
+    }
+    return QueueTail;
+}
+
+// Queue an HLine filling columns x1 up to (but not including) x2 of row y, cut to the clip
+// rectangle (GraphicsClip.c). This is what the filled shapes are made of. The span has to be
+// cut at the left hand edge of the screen anyway because the graphics chip stops an HLine as
+// soon as it reaches a pixel that is off the screen
+unsigned int QueueSpan(int x1, int x2, int y, int Colour)
+{
+    if (ClipSpan(&x1, &x2, y)) {
+        QueueCommand(DrawHLine, x1, y, x2, y, Colour, NULL);
+    }
+    return QueueTail;
+}
+
+/*********************************************************************************************
+** Queue a GetAPixel command that reads the pixel at (x,y) into *Colour, and return its fence.
+** *Colour is only valid once the fence has been reached. It is the colour after everything
+** queued before it has been drawn. If the shadow frame buffer is on (GraphicsShadow.c) the pixel
+** is read from there straight away, and the fence returned has already been reached
+*********************************************************************************************/
+
+unsigned int QueueReadPixel(int x, int y, int *Colour)
+{
+    if (GraphicsShadowEnabled) {
+        *Colour = GraphicsShadow[y & 0x1FF][x & 0x3FF];
+        return QueueDone;
+    }
+    QueueCommand(GetAPixel, x, y, 0, 0, 0, Colour);
+    return QueueTail;
+}
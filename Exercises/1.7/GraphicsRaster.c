@@ -0,0 +1,322 @@
+/************************************************************************************************
+** Software copy of the drawing states in GraphicsController_Verilog.v
+**
+** RasterCommand() draws a command into a copy of the frame buffer memory exactly the way the
+** state machine would (same algorithms, clipping and exclusive x2/y2 end points) and counts the
+** clock cycles it would take. It is used by the host model of the graphics controller and by the
+** shadow frame buffer the driver keeps in DDR memory, so both always agree with the hardware
+***********************************************************************************************/
+
+#include <stddef.h>
+
+#include "Graphics.h"
+
+// limits used by the state machine when clipping
+#define MIN_X 0
+#define MAX_X 799
+#define MIN_Y 0
+#define MAX_Y 479
+
+static unsigned char (*Memory)[GRAPHICS_MEMORY_COLUMNS];     // frame buffer being drawn into
+static short int RasterX1, RasterY1, RasterX2, RasterY2;     // copies of the graphics registers
+static unsigned short int RasterColour;
+static unsigned long Cycles;                // clock cycles used by the command being run
+static unsigned long Pixels;                // pixels written by the command being run
+static int RasterOctants;                   // octants of the circle drawn (Octants register)
+
+/*********************************************************************************************
+** Write to the frame buffer the same way the state machine does, i.e. using the address
+** {Y[8:0], X[9:1]} with X[0] picking the byte, so coordinates wrap at 1024 x 512
+*********************************************************************************************/
+
+static void MemoryWrite(short int x, short int y, unsigned short int Colour)
+{
+    Memory[y & 0x1FF][x & 0x3FF] = (unsigned char)(Colour & 0xFF);
+    Pixels++;
+}
+
+static int OffScreen(short int x, short int y)
+{
+    return x < MIN_X || x > MAX_X || y < MIN_Y || y > MAX_Y;
+}
+
+/*********************************************************************************************
+** One function per command. Each Cycles++ is one state of the state machine
+*********************************************************************************************/
+
+static void RunPutPixel(void)
+{
+    Cycles++;                                               // DrawPixel (no clipping)
+    MemoryWrite(RasterX1, RasterY1, RasterColour);
+}
+
+static void RunHLine(void)
+{
+    short int X1 = RasterX1, Y1 = RasterY1, X2 = RasterX2;
+    short int X_line = X1;
+
+    Cycles++;                                               // LoadCoordinates
+    for(;;) {
+        Cycles++;                                           // DrawHLine
+        if (X_line >= X2 || OffScreen(X_line, Y1))
+            break;
+        MemoryWrite(X_line, Y1, RasterColour);
+        X_line++;
+    }
+}
+
+static void RunVLine(void)
+{
+    short int X1 = RasterX1, Y1 = RasterY1, Y2 = RasterY2;
+    short int Y_line = Y1;
+
+    Cycles++;                                               // LoadCoordinates
+    for(;;) {
+        Cycles++;                                           // DrawVline
+        if (Y_line >= Y2 || OffScreen(X1, Y_line))
+            break;
+        MemoryWrite(X1, Y_line, RasterColour);
+        Y_line++;
+    }
+}
+
+static void RunFilledRect(void)
+{
+    short int X1 = RasterX1, X2 = RasterX2, Y2 = RasterY2;
+    short int X_line = X1, Y_line = RasterY1;
+
+    Cycles++;                                               // LoadCoordinates
+    for(;;) {
+        Cycles++;                                           // DrawFilledRect
+        if (X1 >= X2 || Y_line >= Y2 || Y_line > MAX_Y)
+            break;
+        if (X_line >= X2 || X_line > MAX_X) {
+            X_line = X1;
+            Y_line++;
+            continue;
+        }
+        if (!(X_line < MIN_X || Y_line < MIN_Y))
+            MemoryWrite(X_line, Y_line, RasterColour);
+        if (X_line + 1 >= X2 || X_line + 1 > MAX_X) {
+            X_line = X1;
+            Y_line++;
+        } else {
+            X_line++;
+        }
+    }
+}
+
+static void RunLine(void)
+{
+    short int X1 = RasterX1, Y1 = RasterY1;
+    short int X2 = RasterX2, Y2 = RasterY2;
+    short int x = X1, y = Y1, dx, dy, s1, s2, error, i, temp;
+    int interchange = 0;
+
+    Cycles++;                                               // DrawLine
+    dx = (short int)(X2 - X1);
+    s1 = (dx < 0) ? -1 : (dx == 0) ? 0 : 1;
+    if (dx < 0) dx = -dx;
+    dy = (short int)(Y2 - Y1);
+    s2 = (dy < 0) ? -1 : (dy == 0) ? 0 : 1;
+    if (dy < 0) dy = -dy;
+
+    Cycles++;                                               // DrawLine1
+    if (dx == 0 && dy == 0)
+        return;
+    if (dy > dx) {
+        temp = dx;
+        dx = dy;
+        dy = temp;
+        interchange = 1;
+    }
+
+    Cycles++;                                               // DrawLine2
+    error = (short int)((dy << 1) - dx);
+    i = 1;
+
+    for(;;) {
+        Cycles++;                                           // DrawLineStartMainLoop
+        if (i > dx)
+            break;
+        if (!OffScreen(x, y))
+            MemoryWrite(x, y, RasterColour);
+
+        for(;;) {
+            Cycles++;                                       // DrawLineStartErrorLoop
+            if (error < 0)
+                break;
+            if (interchange == 1)
+                x += s1;
+            else
+                y += s2;
+            error = (short int)(error - (dx << 1));
+        }
+
+        Cycles++;                                           // DrawLineFinishMainLoop
+        if (interchange == 1)
+            y += s2;
+        else
+            x += s1;
+        error = (short int)(error + (dy << 1));
+        i++;
+    }
+}
+
+static void CirclePoint(short int x, short int y, int Octant)
+{
+    Cycles++;                                               // one DrawCircleOctant state
+    if ((RasterOctants & Octant) && !OffScreen(x, y))
+        MemoryWrite(x, y, RasterColour);
+}
+
+static void RunCircle(void)
+{
+    short int centreX = RasterX1, centreY = RasterY1;
+    short int offset_x = RasterX2, offset_y = 0;
+    short int crit = (short int)(1 - offset_x);
+
+    Cycles++;                                               // DrawCircle
+    for(;;) {
+        Cycles++;                                           // DrawCircleStartMainLoop
+        if (offset_y > offset_x)
+            break;
+
+        CirclePoint(centreX + offset_x, centreY + offset_y, ARC_OCTANT_0);
+        CirclePoint(centreX + offset_y, centreY + offset_x, ARC_OCTANT_1);
+        CirclePoint(centreX - offset_x, centreY + offset_y, ARC_OCTANT_3);
+        CirclePoint(centreX - offset_y, centreY + offset_x, ARC_OCTANT_2);
+        CirclePoint(centreX - offset_x, centreY - offset_y, ARC_OCTANT_4);
+        CirclePoint(centreX - offset_y, centreY - offset_x, ARC_OCTANT_5);
+        CirclePoint(centreX + offset_x, centreY - offset_y, ARC_OCTANT_7);
+        CirclePoint(centreX + offset_y, centreY - offset_x, ARC_OCTANT_6);
+
+        Cycles++;                                           // DrawCircleIncreaseOffsetY
+        offset_y++;
+
+        Cycles++;                                           // DrawCircleCheckCrit
+        if (crit <= 0) {
+            crit = (short int)(crit + 2 * offset_y + 1);
+        } else {
+            offset_x--;
+            Cycles++;                                       // DrawCircleEndMainLoop
+            crit = (short int)(crit + 2 * (offset_y - offset_x) + 1);
+        }
+    }
+}
+
+static void EllipsePoints(short int centreX, short int centreY, short int offset_x, short int offset_y)
+{
+    Cycles++;                                               // DrawEllipseQuadrant1
+    if (!OffScreen(centreX + offset_x, centreY + offset_y))
+        MemoryWrite(centreX + offset_x, centreY + offset_y, RasterColour);
+    Cycles++;                                               // DrawEllipseQuadrant2
+    if (!OffScreen(centreX - offset_x, centreY + offset_y))
+        MemoryWrite(centreX - offset_x, centreY + offset_y, RasterColour);
+    Cycles++;                                               // DrawEllipseQuadrant3
+    if (!OffScreen(centreX - offset_x, centreY - offset_y))
+        MemoryWrite(centreX - offset_x, centreY - offset_y, RasterColour);
+    Cycles++;                                               // DrawEllipseQuadrant4
+    if (!OffScreen(centreX + offset_x, centreY - offset_y))
+        MemoryWrite(centreX + offset_x, centreY - offset_y, RasterColour);
+}
+
+// the state machine's ellipse registers are 48 bits, which long long holds
+static void RunEllipse(void)
+{
+    short int centreX = RasterX1, centreY = RasterY1;
+    short int offset_x = 0, offset_y = RasterY2;
+    long long a2 = (long long)RasterX2 * RasterX2;
+    long long b2 = (long long)RasterY2 * RasterY2;
+    long long dx, dy, d;
+
+    Cycles++;                                               // DrawEllipse
+    Cycles++;                                               // DrawEllipse1
+    dx = 0;
+    dy = 2 * a2 * offset_y;
+    d = 4 * b2 - 4 * a2 * offset_y + a2;
+
+    for(;;) {
+        Cycles++;                                           // DrawEllipseStartRegion1
+        if (dx >= dy)
+            break;
+        EllipsePoints(centreX, centreY, offset_x, offset_y);
+
+        Cycles++;                                           // DrawEllipseStepRegion1
+        offset_x++;
+        dx += 2 * b2;
+        if (d < 0) {
+            d += 4 * (dx + b2);
+        } else {
+            offset_y--;
+            dy -= 2 * a2;
+            d += 4 * (dx - dy + b2);
+        }
+    }
+
+    Cycles++;                                               // DrawEllipseRegion2
+    d += 3 * (a2 - b2) - 2 * (dx + dy);
+
+    for(;;) {
+        Cycles++;                                           // DrawEllipseStartRegion2
+        if (offset_y < 0)
+            break;
+        EllipsePoints(centreX, centreY, offset_x, offset_y);
+
+        Cycles++;                                           // DrawEllipseStepRegion2
+        offset_y--;
+        dy -= 2 * a2;
+        if (d > 0) {
+            d += 4 * (a2 - dy);
+        } else {
+            offset_x++;
+            dx += 2 * b2;
+            d += 4 * (dx - dy + a2);
+        }
+    }
+}
+
+/*********************************************************************************************
+** Draw one command into Memory (laid out like the frame buffer sram, 512 rows of 1024 pixels)
+** Returns the number of clock cycles the state machine spends on it, not counting the Idle
+** and ProcessCommand states. Commands that do not draw anything return 0.
+** If PixelCount is not NULL the number of pixels written is added to it
+*********************************************************************************************/
+
+unsigned long RasterCommand(unsigned char (*FrameBuffer)[GRAPHICS_MEMORY_COLUMNS], int Command,
+    int x1, int y1, int x2, int y2, int Colour, unsigned long *PixelCount)
+{
+    Memory = FrameBuffer;
+    RasterX1 = (short int)x1;
+    RasterY1 = (short int)y1;
+    RasterX2 = (short int)x2;
+    RasterY2 = (short int)y2;
+    RasterColour = (unsigned short int)Colour;
+    Cycles = 0;
+    Pixels = 0;
+
+    if (Command == PutAPixel)
+        RunPutPixel();
+    else if (Command == DrawHLine)
+        RunHLine();
+    else if (Command == DrawVLine)
+        RunVLine();
+    else if (Command == DrawLine)
+        RunLine();
+    else if (Command == DrawCircle) {
+        RasterOctants = ARC_CIRCLE;
+        RunCircle();
+    }
+    else if (Command == DrawArc) {
+        RasterOctants = y2 & ARC_CIRCLE;
+        RunCircle();
+    }
+    else if (Command == DrawEllipse)
+        RunEllipse();
+    else if (Command == DrawFilledRect)
+        RunFilledRect();
+
+    if (PixelCount != NULL)
+        *PixelCount += Pixels;
+    return Cycles;
+}
@@ -0,0 +1,98 @@
+/************************************************************************************************
+** Shadow frame buffer
+**
+** An optional copy of the frame buffer kept in the HPS's DDR memory. When it is turned on every
+** drawing command sent to the graphics chip (from Graphics.c or the command queue) is also drawn
+** into the shadow by GraphicsRaster.c, which uses the same algorithms as the graphics chip, so
+** ReadAPixel() can answer from DDR straight away instead of waiting for the graphics chip to
+** finish everything queued and then doing a GetAPixel command.
+**
+** GraphicsShadowCheck() compares the shadow with what is really in the frame buffer, e.g. to test
+** a change to the Verilog or to GraphicsRaster.c
+***********************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Graphics.h"
+
+int GraphicsShadowEnabled = 0;
+unsigned char GraphicsShadow[GRAPHICS_MEMORY_ROWS][GRAPHICS_MEMORY_COLUMNS];
+
+// pixels drawn into the shadow, e.g. to count how many a drawing takes by drawing it off screen
+unsigned long GraphicsShadowPixels = 0;
+
+// the most mismatches GraphicsShadowCheck() will print
+#define SHADOW_MAX_REPORTS      10
+
+/*********************************************************************************************
+** Turn the shadow on. It starts as a copy of what is on the screen now, read back from the
+** graphics chip a pixel at a time, so this takes a while
+*********************************************************************************************/
+
+void GraphicsShadowEnable(void)
+{
+    int x, y;
+
+    GraphicsShadowEnabled = 0;
+    for(y = 0; y < HEIGHT; y++) {
+        for(x = 0; x < WIDTH; x++) {
+            GraphicsShadow[y][x] = (unsigned char)ReadAPixelFromGraphics(x, y);
+        }
+    }
+    GraphicsShadowEnabled = 1;
+}
+
+// Turn the shadow on without reading the screen back, when everything on it is known to be
+// Colour, e.g. just after FillScreen(Colour)
+void GraphicsShadowEnableFilled(int Colour)
+{
+    int y;
+
+    for(y = 0; y < HEIGHT; y++) {
+        memset(GraphicsShadow[y], Colour, WIDTH);
+    }
+    GraphicsShadowEnabled = 1;
+}
+
+void GraphicsShadowDisable(void)
+{
+    GraphicsShadowEnabled = 0;
+}
+
+// Draw a command into the shadow. Called (through SHADOW_COMMAND) whenever the same command
+// is sent to or queued for the graphics chip
+void GraphicsShadowCommand(int Command, int x1, int y1, int x2, int y2, int Colour)
+{
+    RasterCommand(GraphicsShadow, Command, (short int)x1, (short int)y1, (short int)x2, (short int)y2,
+        Colour, &GraphicsShadowPixels);
+}
+
+/*********************************************************************************************
+** Compare the shadow with the frame buffer over the whole screen and print the first few
+** pixels that differ. Returns the number of pixels that differ (0 if the shadow is off)
+*********************************************************************************************/
+
+int GraphicsShadowCheck(void)
+{
+    int x, y, Colour, Mismatches = 0;
+
+    if (!GraphicsShadowEnabled) {
+        return 0;
+    }
+
+    for(y = 0; y < HEIGHT; y++) {
+        for(x = 0; x < WIDTH; x++) {
+            Colour = ReadAPixelFromGraphics(x, y);
+            if (Colour != GraphicsShadow[y][x]) {
+                if (Mismatches < SHADOW_MAX_REPORTS) {
+                    printf("Shadow mismatch at (%d,%d): shadow %d, frame buffer %d\n",
+                        x, y, GraphicsShadow[y][x], Colour);
+                }
+                Mismatches++;
+            }
+        }
+    }
+
+    return Mismatches;
+}
@@ -0,0 +1,350 @@
+/************************************************************************************************
+** Sprites with save-under buffers
+**
+** SpritesUpdate() works out every sprite that moved, was shown or hidden or changed image since
+** the last update, and the rectangles of the screen it was and now is in. Rectangles that
+** overlap (or are so close that one rectangle round both is no bigger) are merged, so a sprite
+** moving a little is one rectangle just bigger than itself. Each rectangle is then put together
+** in memory from the shadow frame buffer (GraphicsShadow.c), which has what is on the screen:
+**
+**  - every sprite in it is taken off, top one first, by putting back the pixels it saved. This
+**    is done in all the rectangles before anything is drawn, since a sprite that moved far can
+**    have its old and new places in different rectangles but has only one save-under buffer
+**  - every sprite that should be in it is drawn, bottom one first, saving what is under it
+**
+** and only the pixels in each row between the first and last one that changed are sent, with
+** BlitRect(). Sprites that did not change but overlap the rectangle are taken off and put back
+** in it too, so they stay on top. Dragging a 32x32 cursor costs about the pixels it covers.
+**
+** Anything drawn over a sprite while it is on the screen wins: a pixel of a sprite that no longer
+** shows the sprite's colour is left alone when the sprite is taken off. Drawing under a sprite
+** is not seen, so hide it (or draw before SpritesUpdate() puts it back) to draw there.
+** Sprites are not clipped by the clip rectangle, only by the edge of the screen
+***********************************************************************************************/
+
+#include <string.h>
+
+#include "Graphics.h"
+#include "GraphicsSprite.h"
+
+typedef struct {
+    int x1, y1, x2, y2;                 // (x1,y1) up to (not including) (x2,y2)
+} SpriteRect;
+
+static Sprite *Sprites[SPRITE_MAX_SPRITES];     // bottom one first
+static int NumSprites = 0;
+
+static SpriteRect Damage[SPRITE_MAX_DAMAGE];
+static int NumDamaged = 0;
+
+// the damaged rectangles as they should look, made up from the shadow frame buffer
+static unsigned char Composite[HEIGHT][WIDTH];
+
+/*********************************************************************************************
+** Set up a sprite of Width x Height pixels. Pixels of the Transparent palette number are not
+** drawn. The sprite is not on the screen until it has been added with SpriteAdd(), shown and
+** SpritesUpdate() called. Returns 0 if it is bigger than SPRITE_MAX_WIDTH x SPRITE_MAX_HEIGHT,
+** leaving a sprite with no pixels that is never drawn
+*********************************************************************************************/
+
+int SpriteInit(Sprite *s, const unsigned char *Pixels, int Width, int Height, int Transparent)
+{
+    memset(s, 0, sizeof(*s));
+    if (Width > SPRITE_MAX_WIDTH || Height > SPRITE_MAX_HEIGHT) {
+        return 0;
+    }
+    s->Pixels = Pixels;
+    s->Width = Width;
+    s->Height = Height;
+    s->Transparent = Transparent;
+    return 1;
+}
+
+// Put s on top of the sprites already added. Returns 0 if there are SPRITE_MAX_SPRITES already
+int SpriteAdd(Sprite *s)
+{
+    if (NumSprites >= SPRITE_MAX_SPRITES) {
+        return 0;
+    }
+    Sprites[NumSprites++] = s;
+    return 1;
+}
+
+void SpriteMove(Sprite *s, int x, int y)
+{
+    s->x = x;
+    s->y = y;
+}
+
+void SpriteSetVisible(Sprite *s, int Visible)
+{
+    s->Visible = (Visible != 0);
+}
+
+// Change the pixels a sprite is drawn with, e.g. to animate it. They have to be the same size
+void SpriteSetImage(Sprite *s, const unsigned char *Pixels)
+{
+    s->Pixels = Pixels;
+}
+
+/*********************************************************************************************
+** Damaged rectangles
+*********************************************************************************************/
+
+static int RectArea(const SpriteRect *r)
+{
+    return (r->x2 - r->x1) * (r->y2 - r->y1);
+}
+
+static void RectUnion(SpriteRect *r, const SpriteRect *With)
+{
+    if (With->x1 < r->x1) r->x1 = With->x1;
+    if (With->y1 < r->y1) r->y1 = With->y1;
+    if (With->x2 > r->x2) r->x2 = With->x2;
+    if (With->y2 > r->y2) r->y2 = With->y2;
+}
+
+// Cut r to the part of it inside Within. Returns 0 if nothing is left
+static int RectIntersect(SpriteRect *r, const SpriteRect *Within)
+{
+    if (Within->x1 > r->x1) r->x1 = Within->x1;
+    if (Within->y1 > r->y1) r->y1 = Within->y1;
+    if (Within->x2 < r->x2) r->x2 = Within->x2;
+    if (Within->y2 < r->y2) r->y2 = Within->y2;
+    return r->x1 < r->x2 && r->y1 < r->y2;
+}
+
+// a and b are better redrawn as one rectangle: they overlap, or one round both is no bigger
+static int RectsMerge(const SpriteRect *a, const SpriteRect *b)
+{
+    SpriteRect Merged = *a;
+
+    if (a->x1 < b->x2 && b->x1 < a->x2 && a->y1 < b->y2 && b->y1 < a->y2) {
+        return 1;
+    }
+    RectUnion(&Merged, b);
+    return RectArea(&Merged) <= RectArea(a) + RectArea(b);
+}
+
+/*********************************************************************************************
+** Note that the Width x Height rectangle with its top left corner at x,y has to be redrawn.
+** It takes in every damaged rectangle it should be merged with, and whatever they in turn
+** should be merged with, so the damaged rectangles never overlap
+*********************************************************************************************/
+
+static void SpriteDamage(int x, int y, int Width, int Height)
+{
+    SpriteRect r, Merged;
+    SpriteRect Screen = { 0, 0, WIDTH, HEIGHT };
+    int i, Best, Growth, BestGrowth;
+
+    r.x1 = x;
+    r.y1 = y;
+    r.x2 = x + Width;
+    r.y2 = y + Height;
+    if (!RectIntersect(&r, &Screen)) {
+        return;
+    }
+
+    for(;;) {
+        for(i = 0; i < NumDamaged; i++) {
+            if (RectsMerge(&Damage[i], &r)) {
+                break;
+            }
+        }
+
+        // with no room left merge it with the one that grows least
+        if (i == NumDamaged && NumDamaged == SPRITE_MAX_DAMAGE) {
+            Best = 0;
+            BestGrowth = -1;
+            for(i = 0; i < NumDamaged; i++) {
+                Merged = Damage[i];
+                RectUnion(&Merged, &r);
+                Growth = RectArea(&Merged) - RectArea(&Damage[i]);
+                if (BestGrowth < 0 || Growth < BestGrowth) {
+                    Best = i;
+                    BestGrowth = Growth;
+                }
+            }
+            i = Best;
+        }
+        if (i == NumDamaged) {
+            break;
+        }
+
+        // take it out, and see if the two together have to be merged with anything else
+        RectUnion(&r, &Damage[i]);
+        Damage[i] = Damage[--NumDamaged];
+    }
+    Damage[NumDamaged++] = r;
+}
+
+// the sprite has to be taken off or put on the screen
+static int SpriteChanged(const Sprite *s)
+{
+    if (s->Visible != s->Drawn) {
+        return 1;
+    }
+    return s->Drawn && (s->x != s->DrawnX || s->y != s->DrawnY || s->Pixels != s->DrawnPixels);
+}
+
+/*********************************************************************************************
+** Putting a damaged rectangle together in Composite
+*********************************************************************************************/
+
+// Put back the pixels that were under the part of s inside r, where it still shows s
+static void TakeOff(const Sprite *s, const SpriteRect *r)
+{
+    SpriteRect Part = { s->DrawnX, s->DrawnY, s->DrawnX + s->Width, s->DrawnY + s->Height };
+    const unsigned char *Pixels;
+    int x, y, i, j;
+
+    if (!RectIntersect(&Part, r)) {
+        return;
+    }
+    for(y = Part.y1; y < Part.y2; y++) {
+        j = y - s->DrawnY;
+        Pixels = s->DrawnPixels + j * s->Width;
+        for(x = Part.x1; x < Part.x2; x++) {
+            i = x - s->DrawnX;
+            // transparent pixels were never drawn, and anything else has been drawn over since
+            if (Pixels[i] != s->Transparent && Composite[y][x] == Pixels[i]) {
+                Composite[y][x] = s->Under[j][i];
+            }
+        }
+    }
+}
+
+// Save what is under the part of s inside r and draw it there
+static void PutOn(Sprite *s, const SpriteRect *r)
+{
+    SpriteRect Part = { s->x, s->y, s->x + s->Width, s->y + s->Height };
+    const unsigned char *Pixels;
+    int x, y, i, j;
+
+    if (!RectIntersect(&Part, r)) {
+        return;
+    }
+    for(y = Part.y1; y < Part.y2; y++) {
+        j = y - s->y;
+        Pixels = s->Pixels + j * s->Width;
+        for(x = Part.x1; x < Part.x2; x++) {
+            i = x - s->x;
+            s->Under[j][i] = Composite[y][x];
+            if (Pixels[i] != s->Transparent) {
+                Composite[y][x] = Pixels[i];
+            }
+        }
+    }
+}
+
+// Columns *Left up to (not including) *Right of row y of r are everything that differs between
+// Composite and the screen. Returns 0 if nothing does
+static int ChangedColumns(const SpriteRect *r, int y, int *Left, int *Right)
+{
+    const unsigned char *New = Composite[y];
+    const unsigned char *Old = GraphicsShadow[y];
+    int l = r->x1, h = r->x2;
+
+    while (l < h && New[l] == Old[l]) {
+        l++;
+    }
+    while (h > l && New[h - 1] == Old[h - 1]) {
+        h--;
+    }
+
+    *Left = l;
+    *Right = h;
+    return l < h;
+}
+
+// Send the pixels of r that changed, with one BlitRect() for rows that changed by the same columns
+static void SendChanges(const SpriteRect *r)
+{
+    int y, First = 0, Left, Right, RunLeft = 0, RunRight = 0, Running = 0;
+
+    for(y = r->y1; y <= r->y2; y++) {
+        if (y == r->y2 || !ChangedColumns(r, y, &Left, &Right)) {
+            Left = Right = 0;
+        }
+        if (Running && (Left != RunLeft || Right != RunRight)) {
+            BlitRect(RunLeft, First, RunRight - RunLeft, y - First, &Composite[First][RunLeft], WIDTH);
+            Running = 0;
+        }
+        if (!Running && Left < Right) {
+            First = y;
+            RunLeft = Left;
+            RunRight = Right;
+            Running = 1;
+        }
+    }
+}
+
+/*********************************************************************************************
+** Put every change to the sprites since the last update on the screen. Call it once a frame,
+** e.g. just before GraphicsEndFrame() (GraphicsVSync.c). Turns the shadow frame buffer on
+** first if it is not already on, which reads the whole screen back from the graphics chip, so
+** it is best turned on once at the start
+*********************************************************************************************/
+
+void SpritesUpdate(void)
+{
+    int i, n, y;
+    Sprite *s;
+    int OldLeft = ClipLeft, OldTop = ClipTop, OldRight = ClipRight, OldBottom = ClipBottom;
+
+    if (!GraphicsShadowEnabled) {
+        GraphicsShadowEnable();
+    }
+
+    NumDamaged = 0;
+    for(i = 0; i < NumSprites; i++) {
+        s = Sprites[i];
+        if (!SpriteChanged(s)) {
+            continue;
+        }
+        if (s->Drawn) {
+            SpriteDamage(s->DrawnX, s->DrawnY, s->Width, s->Height);
+        }
+        if (s->Visible) {
+            SpriteDamage(s->x, s->y, s->Width, s->Height);
+        }
+    }
+
+    // sprites go right up to the edge of the screen whatever the clip rectangle is
+    ResetClipRectangle();
+
+    // take the sprites off in every rectangle before putting any back on (see the top of the file)
+    for(n = 0; n < NumDamaged; n++) {
+        for(y = Damage[n].y1; y < Damage[n].y2; y++) {
+            memcpy(&Composite[y][Damage[n].x1], &GraphicsShadow[y][Damage[n].x1], Damage[n].x2 - Damage[n].x1);
+        }
+        for(i = NumSprites - 1; i >= 0; i--) {
+            if (Sprites[i]->Drawn) {
+                TakeOff(Sprites[i], &Damage[n]);
+            }
+        }
+    }
+    for(n = 0; n < NumDamaged; n++) {
+        for(i = 0; i < NumSprites; i++) {
+            if (Sprites[i]->Visible) {
+                PutOn(Sprites[i], &Damage[n]);
+            }
+        }
+        SendChanges(&Damage[n]);
+    }
+    NumDamaged = 0;
+
+    for(i = 0; i < NumSprites; i++) {
+        s = Sprites[i];
+        s->Drawn = s->Visible;
+        s->DrawnX = s->x;
+        s->DrawnY = s->y;
+        s->DrawnPixels = s->Pixels;
+    }
+
+    ClipLeft = OldLeft;
+    ClipTop = OldTop;
+    ClipRight = OldRight;
+    ClipBottom = OldBottom;
+}
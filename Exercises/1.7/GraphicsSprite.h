@@ -0,0 +1,45 @@
+#ifndef GRAPHICS_SPRITE_H
+#define GRAPHICS_SPRITE_H
+
+/************************************************************************************************
+** Sprites with save-under buffers (GraphicsSprite.c)
+**
+** Small images (a touch cursor, icons being dragged) drawn over whatever is on the screen. Each
+** sprite keeps the pixels that were under it, so it can be moved, hidden or changed without the
+** application redrawing what was behind it. Moving them only changes the Sprite, and
+** SpritesUpdate() puts all the changes since last time on the screen together, once a frame
+***********************************************************************************************/
+
+// biggest sprite, which sets the size of the save-under buffer in every Sprite
+#define SPRITE_MAX_WIDTH        64
+#define SPRITE_MAX_HEIGHT       64
+
+// most sprites on the screen at once
+#define SPRITE_MAX_SPRITES      32
+
+// most separate rectangles of the screen SpritesUpdate() redraws before merging them
+#define SPRITE_MAX_DAMAGE       16
+
+// Transparent for a sprite with no transparent pixels
+#define SPRITE_OPAQUE           -1
+
+typedef struct {
+    const unsigned char *Pixels;        // Width x Height palette numbers, row by row from the top
+    int Width, Height;
+    int Transparent;                    // palette number that is not drawn, or SPRITE_OPAQUE
+    int x, y, Visible;                  // where it should be, top left corner
+
+    // what is on the screen: the pixels it was drawn with, where, and what was under them then
+    const unsigned char *DrawnPixels;
+    int DrawnX, DrawnY, Drawn;
+    unsigned char Under[SPRITE_MAX_HEIGHT][SPRITE_MAX_WIDTH];
+} Sprite;
+
+int SpriteInit(Sprite *s, const unsigned char *Pixels, int Width, int Height, int Transparent);
+int SpriteAdd(Sprite *s);
+void SpriteMove(Sprite *s, int x, int y);
+void SpriteSetVisible(Sprite *s, int Visible);
+void SpriteSetImage(Sprite *s, const unsigned char *Pixels);
+void SpritesUpdate(void);
+
+#endif
@@ -0,0 +1,70 @@
+/************************************************************************************************
+** Waiting for vertical blanking and pacing frames
+**
+** The graphics chip's status register says whether the LCD is in vertical sync (part of
+** vertical blanking, when nothing is being displayed). It also has a "vertical sync seen" bit
+** that is set as each vertical sync starts and stays set until the CPU writes to VSyncClear, so a
+** vertical sync is not missed just because the status register was not being read at the time.
+**
+** GraphicsEndFrame() is called once the CPU has finished drawing a frame. It waits until the
+** frame is due (every refresh unless SetFrameRate() says otherwise) and then, at the start of
+** vertical blanking, advances any colour cycles (GraphicsPalette.c) and flips the frame drawn off
+** screen (GraphicsBackBuffer.c) if there is one, so both change on the same refresh
+***********************************************************************************************/
+
+#include "Graphics.h"
+
+// refreshes from one frame to the next
+static int FrameInterval = 1;
+
+// 1 if the LCD is in vertical sync now
+int InVerticalSync(void)
+{
+    return (GraphicsStatusReg & GRAPHICS_STATUS_VSYNC) != 0;
+}
+
+/*********************************************************************************************
+** Wait for the start of the next vertical sync. Queued commands carry on being sent to the
+** graphics chip while waiting
+*********************************************************************************************/
+
+void WaitForVBlank(void)
+{
+    GraphicsVSyncClearReg = 0;
+    while ((GraphicsStatusReg & GRAPHICS_STATUS_VSYNC_SEEN) == 0) {
+        GraphicsQueueService();
+    }
+    GraphicsVSyncClearReg = 0;          // so the bit shows whether the next one has started yet
+}
+
+// Show a new frame at most FramesPerSecond times a second, i.e. every GRAPHICS_REFRESH_HZ /
+// FramesPerSecond refreshes (rounded). 0 (or anything over GRAPHICS_REFRESH_HZ) means every refresh
+void SetFrameRate(int FramesPerSecond)
+{
+    if (FramesPerSecond <= 0 || FramesPerSecond >= GRAPHICS_REFRESH_HZ) {
+        FrameInterval = 1;
+    } else {
+        FrameInterval = (GRAPHICS_REFRESH_HZ + FramesPerSecond / 2) / FramesPerSecond;
+    }
+}
+
+/*********************************************************************************************
+** Finish a frame: wait until it is due and then, at the start of vertical blanking, cycle the
+** palette and flip the back buffer onto the screen.
+** A vertical sync that started while the frame was being drawn counts towards the wait, but
+** the frame is always shown at the start of a new one so it is never flipped mid refresh
+*********************************************************************************************/
+
+void GraphicsEndFrame(void)
+{
+    int Refreshes = (GraphicsStatusReg & GRAPHICS_STATUS_VSYNC_SEEN) ? 1 : 0;
+
+    do {
+        WaitForVBlank();
+        Refreshes++;
+    } while (Refreshes < FrameInterval);
+
+    // the palette commands are queued first so they are programmed in this vertical sync
+    CyclePalettes();
+    GraphicsFlip();
+}
@@ -0,0 +1,385 @@
+/************************************************************************************************
+** Retained widgets with damaged rectangle redraw
+**
+** Every widget is drawn with a handful of commands (a filled rectangle for its background and
+** border, the runs of its text, the filled part of a bar gauge). Changing one only adds the
+** rectangle of the screen it affects to a short list of damaged rectangles, merging it with one
+** it overlaps. WidgetFlush() then sets the clip rectangle (GraphicsClip.c) to each damaged
+** rectangle in turn and draws the widgets that overlap it, parents before children, so
+** everything outside it is thrown away before it gets to the graphics chip.
+**
+** Changes are kept as small as they can be: a label whose text changes only damages the part
+** from the first character that differs, and a bar gauge only the part of the bar between its old
+** and new value. Redrawing a changed number is then a background span or two plus the runs of
+** the new digits.
+**
+** A widget is expected to lie inside its parent: the children of a widget that does not overlap
+** a damaged rectangle are not looked at
+***********************************************************************************************/
+
+#include <string.h>
+
+#include "Graphics.h"
+#include "GraphicsWidget.h"
+
+typedef struct {
+    int x1, y1, x2, y2;                 // (x1,y1) up to (not including) (x2,y2)
+} WidgetRect;
+
+static WidgetRect Damage[WIDGET_MAX_DAMAGE];
+static int NumDamaged = 0;
+
+static void WidgetInit(Widget *w, int Type, int x, int y, int Width, int Height)
+{
+    memset(w, 0, sizeof(*w));
+    w->Type = Type;
+    w->x = x;
+    w->y = y;
+    w->Width = Width;
+    w->Height = Height;
+    w->Visible = 1;
+    w->Scale = 1;
+}
+
+static void CopyText(Widget *w, const char *Text)
+{
+    strncpy(w->Text, Text, WIDGET_TEXT_SIZE - 1);
+    w->Text[WIDGET_TEXT_SIZE - 1] = '\0';
+}
+
+void WidgetInitPanel(Widget *w, int x, int y, int Width, int Height, int BackgroundColour, int BorderColour)
+{
+    WidgetInit(w, WIDGET_PANEL, x, y, Width, Height);
+    w->BackgroundColour = BackgroundColour;
+    w->BorderColour = BorderColour;
+}
+
+void WidgetInitButton(Widget *w, int x, int y, int Width, int Height, const char *Text, const Font *TextFont,
+    int Scale, int Colour, int BackgroundColour, int BorderColour)
+{
+    WidgetInit(w, WIDGET_BUTTON, x, y, Width, Height);
+    CopyText(w, Text);
+    w->TextFont = TextFont;
+    w->Scale = Scale;
+    w->Colour = Colour;
+    w->BackgroundColour = BackgroundColour;
+    w->BorderColour = BorderColour;
+}
+
+// A label's text is drawn from its top left corner. A BackgroundColour of FONT_TRANSPARENT
+// leaves the parent showing through
+void WidgetInitLabel(Widget *w, int x, int y, int Width, int Height, const char *Text, const Font *TextFont,
+    int Scale, int Colour, int BackgroundColour)
+{
+    WidgetInit(w, WIDGET_LABEL, x, y, Width, Height);
+    CopyText(w, Text);
+    w->TextFont = TextFont;
+    w->Scale = Scale;
+    w->Colour = Colour;
+    w->BackgroundColour = BackgroundColour;
+}
+
+void WidgetInitBarGauge(Widget *w, int x, int y, int Width, int Height, int Value, int Maximum,
+    int Colour, int BackgroundColour, int BorderColour)
+{
+    WidgetInit(w, WIDGET_BAR_GAUGE, x, y, Width, Height);
+    w->Value = Value;
+    w->Maximum = (Maximum > 0) ? Maximum : 1;
+    w->Colour = Colour;
+    w->BackgroundColour = BackgroundColour;
+    w->BorderColour = BorderColour;
+}
+
+// Add Child on top of the children Parent already has
+void WidgetAdd(Widget *Parent, Widget *Child)
+{
+    Widget **Last = &Parent->FirstChild;
+
+    while (*Last != NULL) {
+        Last = &(*Last)->NextSibling;
+    }
+    *Last = Child;
+    Child->Parent = Parent;
+    Child->NextSibling = NULL;
+    WidgetInvalidate(Child);
+}
+
+/*********************************************************************************************
+** Damaged rectangles
+*********************************************************************************************/
+
+static int RectArea(const WidgetRect *r)
+{
+    return (r->x2 - r->x1) * (r->y2 - r->y1);
+}
+
+static void RectUnion(WidgetRect *r, const WidgetRect *With)
+{
+    if (With->x1 < r->x1) r->x1 = With->x1;
+    if (With->y1 < r->y1) r->y1 = With->y1;
+    if (With->x2 > r->x2) r->x2 = With->x2;
+    if (With->y2 > r->y2) r->y2 = With->y2;
+}
+
+static int RectsOverlap(const WidgetRect *a, const WidgetRect *b)
+{
+    return a->x1 < b->x2 && b->x1 < a->x2 && a->y1 < b->y2 && b->y1 < a->y2;
+}
+
+// Note that the Width x Height rectangle with its top left corner at x,y has to be redrawn
+void WidgetDamage(int x, int y, int Width, int Height)
+{
+    WidgetRect r, Merged;
+    int i, Best = 0, Growth, BestGrowth = -1;
+
+    r.x1 = (x < 0) ? 0 : x;
+    r.y1 = (y < 0) ? 0 : y;
+    r.x2 = (x + Width > WIDTH) ? WIDTH : x + Width;
+    r.y2 = (y + Height > HEIGHT) ? HEIGHT : y + Height;
+    if (r.x1 >= r.x2 || r.y1 >= r.y2) {
+        return;
+    }
+
+    // merge it with a rectangle it overlaps. The result may now overlap another one, which
+    // only means a little of the screen is drawn twice
+    for(i = 0; i < NumDamaged; i++) {
+        if (RectsOverlap(&Damage[i], &r)) {
+            RectUnion(&Damage[i], &r);
+            return;
+        }
+    }
+
+    if (NumDamaged < WIDGET_MAX_DAMAGE) {
+        Damage[NumDamaged++] = r;
+        return;
+    }
+
+    // the list is full so merge it with whichever rectangle that grows least
+    for(i = 0; i < NumDamaged; i++) {
+        Merged = Damage[i];
+        RectUnion(&Merged, &r);
+        Growth = RectArea(&Merged) - RectArea(&Damage[i]);
+        if (BestGrowth < 0 || Growth < BestGrowth) {
+            Best = i;
+            BestGrowth = Growth;
+        }
+    }
+    RectUnion(&Damage[Best], &r);
+}
+
+// Note that the whole of w has to be redrawn
+void WidgetInvalidate(Widget *w)
+{
+    WidgetDamage(w->x, w->y, w->Width, w->Height);
+}
+
+/*********************************************************************************************
+** Changing widgets
+*********************************************************************************************/
+
+// x offset from the start of String to its character number Count
+static int TextOffset(const Font *TextFont, const char *String, int Count, int Scale)
+{
+    int Offset = 0;
+    unsigned char c;
+
+    while (Count-- > 0 && (c = (unsigned char)*String++) != '\0') {
+        if (c < FONT_MAX_CHARS) {
+            Offset += TextFont->Advance[c];
+        }
+    }
+    return Offset * Scale;
+}
+
+void WidgetSetText(Widget *w, const char *Text)
+{
+    char Old[WIDGET_TEXT_SIZE];
+    int Same = 0, Left, OldRight, NewRight;
+
+    if (strncmp(w->Text, Text, WIDGET_TEXT_SIZE - 1) == 0) {
+        return;
+    }
+    strcpy(Old, w->Text);
+    CopyText(w, Text);
+
+    if (!w->Visible) {
+        return;
+    }
+    if (w->Type != WIDGET_LABEL) {
+        // button text is centred so all of it moves
+        WidgetInvalidate(w);
+        return;
+    }
+
+    // everything from the first character that differs to the end of the longer text
+    while (Old[Same] != '\0' && Old[Same] == w->Text[Same]) {
+        Same++;
+    }
+    Left = TextOffset(w->TextFont, Old, Same, w->Scale);
+    OldRight = FontStringWidth(w->TextFont, Old, w->Scale);
+    NewRight = FontStringWidth(w->TextFont, w->Text, w->Scale);
+    if (NewRight > OldRight) {
+        OldRight = NewRight;
+    }
+    if (OldRight > w->Width) {
+        OldRight = w->Width;
+    }
+    WidgetDamage(w->x + Left, w->y, OldRight - Left, w->Height);
+}
+
+// columns of a bar gauge's inside (within its border) that are filled at Value
+static int BarFilled(const Widget *w, int Value)
+{
+    int Inside = w->Width - 2;
+
+    if (Value <= 0) {
+        return 0;
+    }
+    if (Value >= w->Maximum) {
+        return Inside;
+    }
+    return (int)((long long)Inside * Value / w->Maximum);
+}
+
+void WidgetSetValue(Widget *w, int Value)
+{
+    int Old = BarFilled(w, w->Value), New = BarFilled(w, Value);
+
+    w->Value = Value;
+    if (Old == New || !w->Visible) {
+        return;
+    }
+    if (Old < New) {
+        WidgetDamage(w->x + 1 + Old, w->y + 1, New - Old, w->Height - 2);
+    } else {
+        WidgetDamage(w->x + 1 + New, w->y + 1, Old - New, w->Height - 2);
+    }
+}
+
+void WidgetSetPressed(Widget *w, int Pressed)
+{
+    if (w->Pressed != Pressed) {
+        w->Pressed = Pressed;
+        WidgetInvalidate(w);
+    }
+}
+
+void WidgetSetVisible(Widget *w, int Visible)
+{
+    if (w->Visible != Visible) {
+        w->Visible = Visible;
+        WidgetInvalidate(w);
+    }
+}
+
+/*********************************************************************************************
+** Drawing
+*********************************************************************************************/
+
+// background with a 1 pixel border, as one rectangle when the border is the same colour
+static void DrawBox(const Widget *w, int Background, int Border)
+{
+    if (Border == Background) {
+        QueueFilledRectangle(w->x, w->y, w->Width, w->Height, Background);
+        return;
+    }
+    QueueFilledRectangle(w->x, w->y, w->Width, 1, Border);
+    QueueFilledRectangle(w->x, w->y + w->Height - 1, w->Width, 1, Border);
+    QueueFilledRectangle(w->x, w->y + 1, 1, w->Height - 2, Border);
+    QueueFilledRectangle(w->x + w->Width - 1, w->y + 1, 1, w->Height - 2, Border);
+    QueueFilledRectangle(w->x + 1, w->y + 1, w->Width - 2, w->Height - 2, Background);
+}
+
+static void DrawWidget(const Widget *w)
+{
+    int Foreground = w->Colour, Background = w->BackgroundColour, Filled;
+
+    switch (w->Type) {
+        case WIDGET_PANEL:
+            DrawBox(w, w->BackgroundColour, w->BorderColour);
+            break;
+
+        case WIDGET_BUTTON:
+            if (w->Pressed) {
+                Foreground = w->BackgroundColour;
+                Background = w->Colour;
+            }
+            DrawBox(w, Background, w->BorderColour);
+            DrawString(w->TextFont,
+                w->x + (w->Width - FontStringWidth(w->TextFont, w->Text, w->Scale)) / 2,
+                w->y + (w->Height - FontHeight(w->TextFont, w->Scale)) / 2,
+                w->Text, w->Scale, Foreground, FONT_TRANSPARENT);
+            break;
+
+        case WIDGET_LABEL:
+            if (w->BackgroundColour != FONT_TRANSPARENT) {
+                QueueFilledRectangle(w->x, w->y, w->Width, w->Height, w->BackgroundColour);
+            }
+            DrawString(w->TextFont, w->x, w->y, w->Text, w->Scale, w->Colour, FONT_TRANSPARENT);
+            break;
+
+        case WIDGET_BAR_GAUGE:
+            Filled = BarFilled(w, w->Value);
+            DrawBox(w, w->BackgroundColour, w->BorderColour);
+            QueueFilledRectangle(w->x + 1, w->y + 1, Filled, w->Height - 2, w->Colour);
+            break;
+    }
+}
+
+// draw w and its children where they overlap the clip rectangle
+static void DrawTree(const Widget *w)
+{
+    const Widget *Child;
+
+    if (!w->Visible || w->x >= ClipRight || w->x + w->Width <= ClipLeft ||
+        w->y >= ClipBottom || w->y + w->Height <= ClipTop) {
+        return;
+    }
+
+    DrawWidget(w);
+    for(Child = w->FirstChild; Child != NULL; Child = Child->NextSibling) {
+        DrawTree(Child);
+    }
+}
+
+/*********************************************************************************************
+** Redraw everything that has been damaged since the last flush, for the tree of widgets under
+** Root. The clip rectangle is put back afterwards. The commands are queued, so this returns
+** before they are all drawn
+*********************************************************************************************/
+
+void WidgetFlush(Widget *Root)
+{
+    int i, OldLeft = ClipLeft, OldTop = ClipTop, OldRight = ClipRight, OldBottom = ClipBottom;
+
+    for(i = 0; i < NumDamaged; i++) {
+        SetClipRectangle(Damage[i].x1, Damage[i].y1, Damage[i].x2 - Damage[i].x1, Damage[i].y2 - Damage[i].y1);
+        DrawTree(Root);
+    }
+    NumDamaged = 0;
+
+    ClipLeft = OldLeft;
+    ClipTop = OldTop;
+    ClipRight = OldRight;
+    ClipBottom = OldBottom;
+}
+
+// The top most visible widget under Root that x,y is in, e.g. the one touched, or NULL if none
+Widget *WidgetAt(Widget *Root, int x, int y)
+{
+    Widget *Child, *Found, *InChild;
+
+    if (!Root->Visible || x < Root->x || x >= Root->x + Root->Width || y < Root->y || y >= Root->y + Root->Height) {
+        return NULL;
+    }
+
+    // children added later are on top
+    Found = Root;
+    for(Child = Root->FirstChild; Child != NULL; Child = Child->NextSibling) {
+        InChild = WidgetAt(Child, x, y);
+        if (InChild != NULL) {
+            Found = InChild;
+        }
+    }
+    return Found;
+}
@@ -0,0 +1,63 @@
+#ifndef GRAPHICS_WIDGET_H
+#define GRAPHICS_WIDGET_H
+
+#include "GraphicsFont.h"
+
+/************************************************************************************************
+** Retained widgets (GraphicsWidget.c)
+**
+** The screen is described by a tree of widgets (panels, buttons, labels and bar gauges) that
+** the application keeps, usually as static variables. Changing a widget through the WidgetSet
+** functions only records the part of the screen that now needs redrawing, and WidgetFlush()
+** redraws just those parts, clipped to them
+***********************************************************************************************/
+
+// kinds of widget
+#define WIDGET_PANEL            0
+#define WIDGET_BUTTON           1
+#define WIDGET_LABEL            2
+#define WIDGET_BAR_GAUGE        3
+
+// longest text a button or label can show, including the terminating 0
+#define WIDGET_TEXT_SIZE        32
+
+// most separate damaged rectangles remembered before they are merged
+#define WIDGET_MAX_DAMAGE       16
+
+typedef struct Widget Widget;
+
+struct Widget {
+    int Type;
+    int x, y, Width, Height;            // on the screen, inside the parent
+    int Colour;                         // text, or the filled part of a bar gauge
+    int BackgroundColour;
+    int BorderColour;                   // panels, buttons and bar gauges have a 1 pixel border
+    int Visible;
+    int Pressed;                        // buttons swap their colours while pressed
+    char Text[WIDGET_TEXT_SIZE];
+    const Font *TextFont;
+    int Scale;
+    int Value, Maximum;                 // bar gauges are filled Value / Maximum of the way across
+    Widget *Parent, *FirstChild, *NextSibling;
+};
+
+void WidgetInitPanel(Widget *w, int x, int y, int Width, int Height, int BackgroundColour, int BorderColour);
+void WidgetInitButton(Widget *w, int x, int y, int Width, int Height, const char *Text, const Font *TextFont,
+    int Scale, int Colour, int BackgroundColour, int BorderColour);
+void WidgetInitLabel(Widget *w, int x, int y, int Width, int Height, const char *Text, const Font *TextFont,
+    int Scale, int Colour, int BackgroundColour);
+void WidgetInitBarGauge(Widget *w, int x, int y, int Width, int Height, int Value, int Maximum,
+    int Colour, int BackgroundColour, int BorderColour);
+void WidgetAdd(Widget *Parent, Widget *Child);
+
+void WidgetSetText(Widget *w, const char *Text);
+void WidgetSetValue(Widget *w, int Value);
+void WidgetSetPressed(Widget *w, int Pressed);
+void WidgetSetVisible(Widget *w, int Visible);
+
+void WidgetDamage(int x, int y, int Width, int Height);
+void WidgetInvalidate(Widget *w);
+void WidgetFlush(Widget *Root);
+Widget *WidgetAt(Widget *Root, int x, int y);
+
+#endif
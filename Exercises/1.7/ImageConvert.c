@@ -0,0 +1,203 @@
+/************************************************************************************************
+** Host (Linux) program that turns a .ppm image into a run length coded image for DrawImage()
+**
+**      gcc -O2 -o ImageConvert ImageConvert.c ColourPaletteData.c
+**      ImageConvert image.ppm Name [transparent-RRGGBB] > Name.c
+**
+** Each pixel becomes the palette number whose colour (in ColourPaletteData.c) is nearest to it.
+** If a transparent colour is given, pixels of exactly that colour are not drawn: they get the
+** palette number nearest to it, and no other pixel is given that palette number.
+** The output is C source for "const RLEImage Name" (see GraphicsImage.h) to build in with
+** GraphicsImage.c. The sizes before and after are printed on stderr
+***********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "GraphicsImage.h"
+
+// the palette ram only has 6 address bits so only 64 of the 256 palette numbers are distinct
+#define CONVERT_PALETTE_SIZE    64
+
+// runs shorter than this go in literals (a run packet is 2 bytes and a command on the board)
+#define CONVERT_MIN_RUN         3
+
+extern const int ColourPaletteData[256];
+
+static unsigned char *Pixels;               // palette numbers, Width x Height
+static int Width, Height;
+
+static unsigned char Row[IMAGE_MAX_LITERAL];     // a literal being coded
+static unsigned long Bytes = 0;
+static int Column = 0;                      // bytes on the output line so far
+
+// skip white space and # comments in a .ppm header, then read a number
+static int ReadHeaderNumber(FILE *fp)
+{
+    int c, Number = 0;
+
+    while ((c = fgetc(fp)) != EOF) {
+        if (c == '#') {
+            while ((c = fgetc(fp)) != EOF && c != '\n') {
+            }
+        }
+        else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            break;
+        }
+    }
+    if (c < '0' || c > '9') {
+        return -1;
+    }
+    while (c >= '0' && c <= '9') {
+        Number = Number * 10 + c - '0';
+        c = fgetc(fp);
+    }
+    return Number;
+}
+
+// palette number nearest to RGB, not counting Exclude (-1 for none)
+static int NearestColour(int RGB, int Exclude)
+{
+    int i, Best = 0, dr, dg, db;
+    long Distance, BestDistance = -1;
+
+    for(i = 0; i < CONVERT_PALETTE_SIZE; i++) {
+        if (i == Exclude) {
+            continue;
+        }
+        dr = ((RGB >> 16) & 0xFF) - ((ColourPaletteData[i] >> 16) & 0xFF);
+        dg = ((RGB >> 8) & 0xFF) - ((ColourPaletteData[i] >> 8) & 0xFF);
+        db = (RGB & 0xFF) - (ColourPaletteData[i] & 0xFF);
+        Distance = (long)dr * dr + (long)dg * dg + (long)db * db;
+        if (BestDistance < 0 || Distance < BestDistance) {
+            Best = i;
+            BestDistance = Distance;
+        }
+    }
+    return Best;
+}
+
+static int ReadPPM(const char *FileName, int TransparentRGB, int Transparent)
+{
+    FILE *fp;
+    int i, Max, RGB;
+
+    fp = fopen(FileName, "rb");
+    if (fp == NULL) {
+        perror(FileName);
+        return 0;
+    }
+    if (fgetc(fp) != 'P' || fgetc(fp) != '6' || (Width = ReadHeaderNumber(fp)) <= 0 ||
+        (Height = ReadHeaderNumber(fp)) <= 0 || (Max = ReadHeaderNumber(fp)) != 255) {
+        fprintf(stderr, "%s: not a binary .ppm with 8 bit colours\n", FileName);
+        fclose(fp);
+        return 0;
+    }
+
+    Pixels = malloc((size_t)Width * Height);
+    if (Pixels == NULL) {
+        fclose(fp);
+        return 0;
+    }
+    for(i = 0; i < Width * Height; i++) {
+        RGB = fgetc(fp) << 16;
+        RGB |= fgetc(fp) << 8;
+        RGB |= fgetc(fp);
+        if (feof(fp)) {
+            fprintf(stderr, "%s: too short\n", FileName);
+            fclose(fp);
+            return 0;
+        }
+        if (Transparent != IMAGE_OPAQUE && RGB == TransparentRGB) {
+            Pixels[i] = (unsigned char)Transparent;
+        } else {
+            Pixels[i] = (unsigned char)NearestColour(RGB, Transparent);
+        }
+    }
+
+    fclose(fp);
+    return 1;
+}
+
+static void OutputByte(int Byte)
+{
+    printf("%s0x%02X,", (Column == 0) ? "    " : " ", Byte);
+    if (++Column == 16) {
+        printf("\n");
+        Column = 0;
+    }
+    Bytes++;
+}
+
+// number of pixels from Start (up to Max) that are the same palette number
+static int RepeatLength(const unsigned char *Line, int Start, int Max)
+{
+    int i = Start + 1;
+
+    while (i < Width && i - Start < Max && Line[i] == Line[Start]) {
+        i++;
+    }
+    return i - Start;
+}
+
+// Output the packets for one row (see GraphicsImage.h)
+static void EncodeRow(const unsigned char *Line, int Transparent)
+{
+    int x = 0, Run, i;
+
+    while (x < Width) {
+        Run = RepeatLength(Line, x, IMAGE_MAX_RUN);
+        if (Run >= CONVERT_MIN_RUN || Line[x] == Transparent) {
+            OutputByte(IMAGE_RUN + Run - 1);
+            OutputByte(Line[x]);
+            x += Run;
+        }
+        else {
+            // palette numbers one at a time until a run or a transparent pixel comes along
+            Run = 0;
+            do {
+                Row[Run++] = Line[x++];
+            } while (x < Width && Run < IMAGE_MAX_LITERAL && Line[x] != Transparent &&
+                     RepeatLength(Line, x, CONVERT_MIN_RUN) < CONVERT_MIN_RUN);
+
+            OutputByte(IMAGE_LITERAL + Run - 1);
+            for(i = 0; i < Run; i++) {
+                OutputByte(Row[i]);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int y, TransparentRGB = 0, Transparent = IMAGE_OPAQUE;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s image.ppm Name [transparent-RRGGBB] > Name.c\n", argv[0]);
+        return 1;
+    }
+    if (argc > 3) {
+        TransparentRGB = (int)strtol(argv[3], NULL, 16);
+        Transparent = NearestColour(TransparentRGB, IMAGE_OPAQUE);
+    }
+    if (!ReadPPM(argv[1], TransparentRGB, Transparent)) {
+        return 1;
+    }
+
+    printf("/* %s converted by ImageConvert */\n\n", argv[1]);
+    printf("#include \"GraphicsImage.h\"\n\n");
+    printf("static const unsigned char %sData[] = {\n", argv[2]);
+    for(y = 0; y < Height; y++) {
+        EncodeRow(&Pixels[y * Width], Transparent);
+    }
+    if (Column != 0) {
+        printf("\n");
+    }
+    printf("};\n\n");
+    printf("const RLEImage %s = { %d, %d, %d, %sData };\n", argv[2], Width, Height, Transparent, argv[2]);
+
+    fprintf(stderr, "%d x %d pixels = %d bytes, coded in %lu bytes\n", Width, Height, Width * Height, Bytes);
+    free(Pixels);
+    return 0;
+}
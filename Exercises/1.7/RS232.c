@@ -0,0 +1,158 @@
+/************************************************************************************************
+** RS232 serial port driver
+**
+** The same routines as Exercises/1.3/exercise1_3.c, so other modules (e.g. GraphicsCapture.c)
+** can use the serial port. The baud rate is worked out from BaudRate instead of being fixed
+** at 9600, the line control register is set for 8 bit characters so binary data gets
+** through unchanged, and the 16 byte FIFOs are left on so received bytes are not lost between polls
+***********************************************************************************************/
+
+#include <stdio.h>
+
+#include "RS232.h"
+
+#ifdef GRAPHICS_HOST_MODEL
+
+static FILE *RS232Output = NULL;
+
+void Init_RS232(int BaudRate)
+{
+    (void)BaudRate;
+    if (RS232Output == NULL) {
+        RS232Output = fopen(RS232_HOST_OUTPUT, "wb");
+    }
+}
+
+int RS232TestForReceivedData(void)
+{
+    return 0;
+}
+
+int putcharRS232(int c)
+{
+    if (RS232Output == NULL) {
+        Init_RS232(0);
+    }
+    if (RS232Output != NULL) {
+        fputc(c, RS232Output);
+        fflush(RS232Output);
+    }
+    return c;
+}
+
+// nothing is ever received on the host (see RS232TestForReceivedData)
+int getcharRS232(void)
+{
+    return 0;
+}
+
+void RS232Flush(void)
+{
+}
+
+#else
+
+#define RS232_ReceiverFifo (*(volatile unsigned char *)(0xFF210200))
+#define RS232_TransmitterFifo (*(volatile unsigned char *)(0xFF210200))
+#define RS232_InterruptEnableReg (*(volatile unsigned char *)(0xFF210202))
+#define RS232_InterruptIdentificationReg (*(volatile unsigned char *)(0xFF210204))
+#define RS232_FifoControlReg (*(volatile unsigned char *)(0xFF210204))
+#define RS232_LineControlReg (*(volatile unsigned char *)(0xFF210206))
+#define RS232_ModemControlReg (*(volatile unsigned char *)(0xFF210208))
+#define RS232_LineStatusReg (*(volatile unsigned char *)(0xFF21020A))
+#define RS232_ModemStatusReg (*(volatile unsigned char *)(0xFF21020C))
+#define RS232_ScratchReg (*(volatile unsigned char *)(0xFF21020E))
+#define RS232_DivisorLatchLSB (*(volatile unsigned char *)(0xFF210200))
+#define RS232_DivisorLatchMSB (*(volatile unsigned char *)(0xFF210202))
+
+#define RS232_LineControlReg_WordLengthSelect0 0
+#define RS232_LineControlReg_WordLengthSelect1 1
+#define RS232_LineControlReg_DivisorLatchAccessBit 7
+
+#define RS232_FifoControlReg_FIFOEnable 0
+#define RS232_FifoControlReg_ReceiveFIFOReset 1
+#define RS232_FifoControlReg_TransmitFIFOReset 2
+
+#define RS232_LineStatusReg_DataReady 0
+#define RS232_LineStatusReg_TransmitterHoldingRegister 5
+
+/**************************************************************************
+ Subroutine to initialise the RS232 Port by writing some data
+ to the internal registers.
+ Call this function at the start of the program before you attempt
+ to read or write to data via the RS232 port
+
+ The divisor is the UART clock / (16 x baud rate), e.g. 0x0145 for 9600
+
+ Refer to UART data sheet for details of registers and programming
+***************************************************************************/
+void Init_RS232(int BaudRate)
+{
+    int Divisor = (RS232_CLOCK_HZ + 8 * BaudRate) / (16 * BaudRate);
+
+ // set bit 7 of Line Control Register to 1, to gain access to the baud rate registers
+    RS232_LineControlReg = (1 << RS232_LineControlReg_DivisorLatchAccessBit);
+
+ // set Divisor latch (LSB and MSB) with correct value for required baud rate
+    RS232_DivisorLatchLSB = Divisor & 0xFF;
+    RS232_DivisorLatchMSB = (Divisor >> 8) & 0xFF;
+
+ // set bit 7 of Line control register back to 0 and
+ // program other bits in that reg for 8 bit data, 1 stop bit, no parity etc
+    RS232_LineControlReg = (1 << RS232_LineControlReg_WordLengthSelect0) + (1 << RS232_LineControlReg_WordLengthSelect1);
+
+ // Turn the Fifo's on (bit 0, which has to be set for the other bits to be written) and reset them by setting bits 1 & 2
+    RS232_FifoControlReg = (1 << RS232_FifoControlReg_FIFOEnable) + (1 << RS232_FifoControlReg_ReceiveFIFOReset) +
+        (1 << RS232_FifoControlReg_TransmitFIFOReset);
+
+ // Now Clear the other bits in the FiFo control register but leave the 16 byte FiFos on,
+ // so at 115200 baud received characters only have to be read every 1.4ms instead of every character
+    RS232_FifoControlReg = (1 << RS232_FifoControlReg_FIFOEnable);
+}
+
+// the following function polls the UART to determine if any character
+// has been received. It doesn't wait for one, or read it, it simply tests
+// to see if one is available to read from the FIFO
+int RS232TestForReceivedData(void)
+{
+    return ((RS232_LineStatusReg >> RS232_LineStatusReg_DataReady) & 1) == 1;
+}
+
+int putcharRS232(int c)
+{
+ // wait for Transmitter Holding Register bit (5) of line status register to be '1'
+ // indicating we can write to the device
+    while (((RS232_LineStatusReg >> RS232_LineStatusReg_TransmitterHoldingRegister) & 1) == 0) {
+    }
+
+ // write character to Transmitter fifo register
+    RS232_TransmitterFifo = c;
+
+ // return the character we printed
+    return c;
+}
+
+int getcharRS232(void)
+{
+ // wait for Data Ready bit (0) of line status register to be '1'
+    while(!RS232TestForReceivedData()) {
+    }
+
+ // read new character from ReceiverFiFo register
+    return RS232_ReceiverFifo;
+}
+
+//
+// Remove/flush the UART receiver buffer by removing any unread characters
+//
+void RS232Flush(void)
+{
+    int read;
+
+    while(RS232TestForReceivedData()) {
+        read = RS232_ReceiverFifo;
+        read += 1;
+    }
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef RS232_H
+#define RS232_H
+
+// RS232 port (16550 UART at hex FF210200, see Exercises/1.3)
+//
+// When compiled for the host (gcc -DGRAPHICS_HOST_MODEL) characters sent go to the file
+// RS232_HOST_OUTPUT and nothing is ever received
+
+#define RS232_HOST_OUTPUT       "RS232.out"
+
+// clock the UART divides down to get its baud rate
+#define RS232_CLOCK_HZ          50000000
+
+void Init_RS232(int BaudRate);
+int RS232TestForReceivedData(void);
+int putcharRS232(int c);
+int getcharRS232(void);
+void RS232Flush(void);
+
+#endif